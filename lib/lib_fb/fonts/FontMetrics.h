@@ -0,0 +1,365 @@
+//-----------------------------------------------------------------------------
+#ifndef __FONT_METRICS_H__
+#define __FONT_METRICS_H__
+/* generated by tools/gen_font_metrics.py : {left, width} ink columns */
+const PROGMEM unsigned char FONT_ASCII_8x8_EXT[128][2] = {
+	{ 0, 0}, { 1, 7}, { 1, 7}, { 1, 7}, { 1, 7}, { 1, 7}, { 1, 7}, { 2, 5},
+	{ 0, 8}, { 2, 5}, { 0, 8}, { 1, 7}, { 2, 5}, { 1, 5}, { 1, 7}, { 1, 7},
+	{ 1, 7}, { 1, 7}, { 2, 5}, { 1, 6}, { 1, 7}, { 1, 6}, { 1, 7}, { 2, 5},
+	{ 1, 7}, { 1, 7}, { 1, 7}, { 1, 7}, { 1, 7}, { 1, 7}, { 1, 7}, { 1, 7},
+	{ 0, 0}, { 2, 4}, { 2, 5}, { 1, 7}, { 2, 5}, { 1, 6}, { 1, 7}, { 2, 3},
+	{ 3, 4}, { 1, 4}, { 1, 7}, { 2, 5}, { 1, 3}, { 2, 4}, { 1, 2}, { 1, 6},
+	{ 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6},
+	{ 1, 6}, { 1, 6}, { 3, 2}, { 2, 3}, { 2, 5}, { 2, 4}, { 1, 5}, { 1, 6},
+	{ 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6},
+	{ 1, 6}, { 2, 4}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 7}, { 1, 7}, { 1, 6},
+	{ 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 7},
+	{ 1, 7}, { 1, 6}, { 1, 6}, { 3, 4}, { 1, 6}, { 1, 4}, { 1, 7}, { 1, 7},
+	{ 4, 3}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6},
+	{ 1, 6}, { 2, 4}, { 1, 5}, { 1, 6}, { 3, 2}, { 1, 7}, { 1, 6}, { 1, 6},
+	{ 1, 6}, { 1, 7}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 6}, { 1, 7},
+	{ 1, 6}, { 1, 6}, { 2, 4}, { 2, 5}, { 3, 2}, { 1, 5}, { 1, 6}, { 1, 7},
+};
+
+const PROGMEM unsigned char FONT_ASCII_8x16_EXT[256][2] = {
+	{ 0, 0}, { 0, 8}, { 0, 8}, { 1, 7}, { 1, 7}, { 0, 8}, { 0, 8}, { 2, 4},
+	{ 1, 7}, { 2, 5}, { 1, 7}, { 1, 7}, { 1, 7}, { 1, 6}, { 1, 7}, { 0, 8},
+	{ 2, 5}, { 2, 5}, { 1, 6}, { 2, 6}, { 0, 8}, { 1, 7}, { 1, 6}, { 0, 8},
+	{ 1, 6}, { 1, 6}, { 1, 7}, { 1, 7}, { 0, 8}, { 0, 8}, { 1, 7}, { 1, 7},
+	{ 0, 0}, { 2, 4}, { 1, 6}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 1, 3},
+	{ 2, 4}, { 2, 4}, { 0, 8}, { 1, 6}, { 2, 3}, { 0, 7}, { 3, 2}, { 0, 7},
+	{ 0, 7}, { 1, 6}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7},
+	{ 0, 7}, { 0, 7}, { 3, 2}, { 2, 3}, { 1, 6}, { 1, 6}, { 1, 6}, { 0, 7},
+	{ 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7},
+	{ 0, 7}, { 2, 4}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7},
+	{ 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 1, 6}, { 0, 7}, { 0, 7}, { 0, 7},
+	{ 0, 7}, { 1, 6}, { 0, 7}, { 2, 4}, { 0, 7}, { 2, 4}, { 0, 7}, { 0, 8},
+	{ 2, 3}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 6}, { 0, 7},
+	{ 0, 7}, { 2, 4}, { 1, 6}, { 0, 7}, { 2, 4}, { 0, 7}, { 0, 7}, { 0, 7},
+	{ 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 1, 6}, { 0, 7},
+	{ 0, 7}, { 0, 7}, { 0, 7}, { 1, 6}, { 3, 2}, { 1, 6}, { 0, 7}, { 0, 7},
+	{ 0, 8}, { 1, 7}, { 1, 7}, { 1, 7}, { 1, 7}, { 1, 7}, { 1, 7}, { 1, 6},
+	{ 1, 7}, { 1, 7}, { 1, 7}, { 1, 6}, { 1, 6}, { 2, 5}, { 1, 7}, { 1, 7},
+	{ 1, 7}, { 0, 8}, { 0, 8}, { 1, 7}, { 1, 7}, { 1, 7}, { 0, 7}, { 0, 7},
+	{ 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 8}, { 0, 8}, { 1, 6},
+	{ 0, 7}, { 2, 4}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 5}, { 0, 4},
+	{ 0, 7}, { 0, 7}, { 1, 7}, { 0, 7}, { 0, 7}, { 2, 4}, { 0, 8}, { 0, 8},
+	{ 1, 7}, { 1, 7}, { 1, 7}, { 3, 2}, { 0, 5}, { 0, 5}, { 0, 7}, { 0, 7},
+	{ 0, 5}, { 0, 7}, { 2, 5}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 5}, { 0, 5},
+	{ 3, 5}, { 0, 8}, { 0, 8}, { 3, 5}, { 0, 8}, { 0, 8}, { 3, 5}, { 2, 6},
+	{ 2, 6}, { 2, 6}, { 0, 8}, { 0, 8}, { 2, 6}, { 0, 8}, { 0, 8}, { 0, 8},
+	{ 0, 8}, { 0, 8}, { 0, 8}, { 2, 6}, { 3, 5}, { 3, 5}, { 2, 6}, { 0, 8},
+	{ 0, 8}, { 0, 5}, { 3, 5}, { 0, 8}, { 0, 8}, { 0, 4}, { 4, 4}, { 0, 8},
+	{ 0, 8}, { 1, 6}, { 1, 6}, { 0, 7}, { 0, 7}, { 0, 7}, { 0, 7}, { 1, 6},
+	{ 0, 7}, { 1, 6}, { 0, 8}, { 1, 6}, { 0, 7}, { 0, 8}, { 0, 7}, { 0, 8},
+	{ 1, 6}, { 0, 7}, { 0, 7}, { 0, 7}, { 3, 5}, { 0, 5}, { 1, 6}, { 0, 7},
+	{ 1, 5}, { 3, 2}, { 3, 2}, { 1, 6}, { 0, 5}, { 1, 4}, { 1, 6}, { 0, 0},
+};
+
+const PROGMEM unsigned char FONT_ASCII_16x32_EXT[256][2] = {
+	{ 0,14}, { 0,16}, { 0,16}, { 0,14}, { 0,14}, { 0,16}, { 0,16}, { 4, 8},
+	{ 0,16}, { 2,12}, { 0,16}, { 0,14}, { 2,12}, { 0,16}, { 0,16}, { 0,16},
+	{ 0,14}, { 0,14}, { 2,12}, { 2,12}, { 0,16}, { 0,14}, { 0,14}, { 2,12},
+	{ 2,12}, { 2,12}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14},
+	{ 0, 0}, { 4, 8}, { 2,12}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 2, 6},
+	{ 4, 8}, { 4, 8}, { 0,14}, { 1,12}, { 4, 6}, { 0,14}, { 6, 4}, { 0,14},
+	{ 0,14}, { 2,12}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14},
+	{ 0,14}, { 0,14}, { 6, 4}, { 4, 6}, { 2,12}, { 0,14}, { 2,12}, { 0,14},
+	{ 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14},
+	{ 0,14}, { 3, 8}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14},
+	{ 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14},
+	{ 0,14}, { 2,12}, { 0,14}, { 4, 8}, { 0,14}, { 4, 8}, { 0,14}, { 0,16},
+	{ 4, 6}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,12}, { 0,14},
+	{ 0,14}, { 3, 8}, { 2,12}, { 0,14}, { 3, 8}, { 0,14}, { 0,14}, { 0,14},
+	{ 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 2,12}, { 0,14},
+	{ 0,14}, { 0,14}, { 0,14}, { 2,12}, { 6, 4}, { 2,12}, { 0,14}, { 0,14},
+	{ 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 2,12},
+	{ 0,14}, { 0,14}, { 0,14}, { 2,12}, { 2,12}, { 2,10}, { 0,14}, { 0,14},
+	{ 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14},
+	{ 0,14}, { 0,14}, { 0,14}, { 2,12}, { 0,14}, { 2,12}, { 0,14}, { 0,16},
+	{ 0,14}, { 4, 8}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 2,12}, { 2,10},
+	{ 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 4, 8}, { 0,14}, { 0,14},
+	{ 2,14}, { 0,16}, { 0,16}, { 6, 4}, { 0,10}, { 0,10}, { 0,14}, { 0,14},
+	{ 0,10}, { 0,14}, { 4,10}, { 0,14}, { 0,14}, { 0,14}, { 0,10}, { 0,10},
+	{ 6,10}, { 0,16}, { 0,16}, { 6,10}, { 0,16}, { 0,16}, { 6,10}, { 4,12},
+	{ 4,12}, { 4,12}, { 0,16}, { 0,16}, { 4,12}, { 0,16}, { 0,16}, { 0,16},
+	{ 0,16}, { 0,16}, { 0,16}, { 4,12}, { 6,10}, { 6,10}, { 4,12}, { 0,16},
+	{ 0,16}, { 0,10}, { 6,10}, { 0,16}, { 0,16}, { 0, 8}, { 8, 8}, { 0,16},
+	{ 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14}, { 0,14},
+	{ 2,12}, { 0,14}, { 0,14}, { 2,12}, { 0,16}, { 0,16}, { 2,10}, { 0,14},
+	{ 0,14}, { 0,14}, { 1,12}, { 1,12}, { 6,10}, { 0,10}, { 0,14}, { 0,14},
+	{ 2,10}, { 6, 4}, { 6, 4}, { 0,16}, { 0,12}, { 0,10}, { 2,10}, { 0, 0},
+};
+
+const PROGMEM unsigned char FONT_HANGUL1_EXT[160][2] = {
+	{ 0, 0}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 9}, { 1, 8}, { 1, 7},
+	{ 1, 7}, { 0, 9}, { 1, 8}, { 0, 9}, { 1, 7}, { 1, 8}, { 0, 9}, { 1, 7},
+	{ 1, 8}, { 1, 8}, { 1, 9}, { 1, 8}, { 0, 0}, { 3, 9}, { 2,11}, { 3,10},
+	{ 2,10}, { 2,11}, { 3, 9}, { 3, 9}, { 3, 9}, { 2,11}, { 2,11}, { 2,11},
+	{ 4, 7}, { 3,10}, { 2,11}, { 2,11}, { 3, 9}, { 3, 9}, { 3,10}, { 3,10},
+	{ 0, 0}, { 3, 9}, { 3,10}, { 3, 9}, { 3, 9}, { 2,10}, { 3, 9}, { 3, 9},
+	{ 3, 8}, { 3, 9}, { 3,10}, { 2,11}, { 5, 6}, { 2,11}, { 2,12}, { 2,11},
+	{ 4, 8}, { 3, 9}, { 3,10}, { 4, 8}, { 0, 0}, { 2, 7}, { 1, 8}, { 1, 8},
+	{ 1, 8}, { 0, 9}, { 1, 8}, { 1, 8}, { 1, 8}, { 0, 9}, { 1, 8}, { 0, 9},
+	{ 2, 7}, { 1, 8}, { 1, 8}, { 1, 8}, { 2, 7}, { 1, 8}, { 1, 7}, { 1, 8},
+	{ 0, 0}, { 2, 7}, { 1, 8}, { 2, 7}, { 2, 7}, { 1, 8}, { 2, 7}, { 2, 7},
+	{ 2, 7}, { 0, 9}, { 1, 8}, { 1, 8}, { 2, 6}, { 2, 7}, { 1, 9}, { 1, 8},
+	{ 3, 6}, { 2, 7}, { 2, 7}, { 2, 7}, { 0, 0}, { 1, 7}, { 1, 8}, { 1, 7},
+	{ 1, 8}, { 1, 8}, { 1, 8}, { 1, 7}, { 1, 7}, { 0, 9}, { 1, 7}, { 1, 8},
+	{ 2, 6}, { 1, 7}, { 1, 8}, { 1, 7}, { 1, 7}, { 1, 8}, { 1, 8}, { 1, 7},
+	{ 0, 0}, { 4, 8}, { 2,11}, { 4, 8}, { 4, 8}, { 3, 9}, { 4, 8}, { 4, 8},
+	{ 4, 8}, { 3, 9}, { 2,11}, { 2,11}, { 5, 6}, { 2,11}, { 2,11}, { 2,11},
+	{ 3, 9}, { 4, 7}, { 4, 8}, { 4, 8}, { 0, 0}, { 2, 6}, { 1, 8}, { 2, 7},
+	{ 2, 7}, { 1, 8}, { 2, 7}, { 2, 6}, { 2, 6}, { 0, 9}, { 1, 8}, { 1, 8},
+	{ 3, 5}, { 1, 8}, { 1, 8}, { 2, 7}, { 2, 6}, { 2, 6}, { 2, 7}, { 2, 7},
+};
+
+const PROGMEM unsigned char FONT_HANGUL2_EXT[88][2] = {
+	{ 0, 0}, {10, 6}, { 9, 6}, {10, 6}, { 9, 6}, { 8, 6}, { 7, 8}, { 8, 6},
+	{ 7, 8}, { 1,14}, { 1,15}, { 1,14}, { 1,13}, { 1,14}, { 1,14}, { 1,13},
+	{ 1,14}, { 1,13}, { 1,14}, { 1,14}, { 1,13}, {11, 3}, { 0, 0}, {10, 6},
+	{ 9, 6}, {10, 6}, { 9, 6}, { 8, 6}, { 7, 8}, { 8, 6}, { 7, 8}, { 1,14},
+	{ 1,15}, { 1,14}, { 1,13}, { 1,14}, { 1,14}, { 1,13}, { 1,14}, { 1,13},
+	{ 1,14}, { 1,14}, { 1,13}, {11, 3}, { 0, 0}, {10, 6}, { 9, 6}, {10, 6},
+	{ 9, 6}, { 8, 6}, { 7, 8}, { 8, 6}, { 8, 7}, { 1,14}, { 1,15}, { 1,14},
+	{ 1,13}, { 1,14}, { 1,14}, { 1,13}, { 1,14}, { 1,13}, { 1,14}, { 1,14},
+	{ 1,13}, {11, 3}, { 0, 0}, {10, 6}, { 9, 6}, {10, 6}, { 9, 6}, { 8, 6},
+	{ 7, 8}, { 8, 6}, { 8, 7}, { 1,14}, { 1,15}, { 1,14}, { 1,13}, { 1,14},
+	{ 1,14}, { 1,13}, { 1,14}, { 1,13}, { 1,14}, { 1,14}, { 1,13}, {11, 3},
+};
+
+const PROGMEM unsigned char FONT_HANGUL3_EXT[112][2] = {
+	{ 0, 0}, { 4, 9}, { 3,10}, { 3,11}, { 5, 9}, { 3,12}, { 3,11}, { 4, 9},
+	{ 5, 8}, { 4,10}, { 4,10}, { 4,10}, { 4,11}, { 4,10}, { 4,10}, { 4,10},
+	{ 5, 8}, { 5, 8}, { 4,11}, { 4, 9}, { 3,11}, { 6, 7}, { 4, 9}, { 4, 9},
+	{ 5, 8}, { 5, 8}, { 5, 8}, { 5, 8}, { 0, 0}, { 5, 9}, { 4,10}, { 4,11},
+	{ 6, 9}, { 4,12}, { 4,11}, { 5, 9}, { 5, 8}, { 5,10}, { 5,10}, { 4,10},
+	{ 4,11}, { 4,10}, { 4,10}, { 5,10}, { 6, 8}, { 5, 8}, { 4,11}, { 5, 9},
+	{ 4,11}, { 7, 7}, { 5, 9}, { 5, 9}, { 6, 8}, { 6, 8}, { 6, 8}, { 6, 8},
+	{ 0, 0}, { 5, 9}, { 5,10}, { 4,11}, { 6, 9}, { 4,12}, { 4,11}, { 6, 9},
+	{ 6, 8}, { 5,10}, { 5,10}, { 5,10}, { 5,11}, { 5,10}, { 5,10}, { 5,10},
+	{ 6, 8}, { 6, 8}, { 5,11}, { 5, 9}, { 4,11}, { 7, 7}, { 5, 9}, { 5, 9},
+	{ 6, 8}, { 6, 8}, { 6, 8}, { 6, 8}, { 0, 0}, { 4, 8}, { 4, 8}, { 3,11},
+	{ 4, 9}, { 3,11}, { 3,10}, { 4, 8}, { 5, 7}, { 3,10}, { 3,10}, { 3,10},
+	{ 3,11}, { 3,10}, { 3,10}, { 3,10}, { 4, 8}, { 4, 8}, { 3,11}, { 3, 9},
+	{ 2,11}, { 5, 6}, { 4, 9}, { 4, 9}, { 4, 8}, { 4, 8}, { 4, 8}, { 4, 8},
+};
+
+const PROGMEM unsigned char FONT_HANBOOT1_EXT[160][2] = {
+	{ 0, 0}, { 1, 7}, { 0, 8}, { 0,10}, { 1, 9}, { 1, 9}, { 1, 8}, { 1, 8},
+	{ 1, 7}, { 0, 9}, { 0, 9}, { 1, 8}, { 1, 7}, { 0, 9}, { 0, 9}, { 0, 8},
+	{ 0, 7}, { 1, 8}, { 1, 8}, { 1, 8}, { 0, 0}, { 3, 9}, { 2,11}, { 4, 9},
+	{ 3,10}, { 2,11}, { 3, 9}, { 3, 9}, { 3, 9}, { 2,11}, { 1,12}, { 2,10},
+	{ 4, 7}, { 2,10}, { 1,11}, { 2,10}, { 3, 9}, { 3, 9}, { 3,10}, { 3, 9},
+	{ 0, 0}, { 4, 8}, { 3,10}, { 3, 9}, { 4, 8}, { 2,11}, { 3,10}, { 3, 9},
+	{ 3, 8}, { 3, 9}, { 2,10}, { 1,12}, { 5, 6}, { 1,11}, { 1,12}, { 1,11},
+	{ 4, 8}, { 4, 9}, { 3,10}, { 4, 8}, { 0, 0}, { 2, 7}, { 1, 8}, { 1, 8},
+	{ 2, 8}, { 0, 9}, { 1, 8}, { 1, 8}, { 1, 8}, { 0, 9}, { 1, 8}, { 0, 9},
+	{ 2, 7}, { 1, 8}, { 1, 8}, { 1, 8}, { 2, 7}, { 1, 9}, { 1, 7}, { 1, 8},
+	{ 0, 0}, { 2, 7}, { 1, 8}, { 2, 7}, { 3, 7}, { 1, 9}, { 2, 7}, { 2, 7},
+	{ 2, 7}, { 0, 9}, { 1, 8}, { 1, 8}, { 2, 6}, { 2, 7}, { 1, 9}, { 1, 8},
+	{ 2, 7}, { 3, 7}, { 2, 7}, { 2, 7}, { 0, 0}, { 2, 6}, { 1, 8}, { 2, 8},
+	{ 2, 8}, { 1, 8}, { 1, 8}, { 1, 7}, { 1, 7}, { 0, 9}, { 1, 7}, { 1, 8},
+	{ 2, 6}, { 1, 7}, { 1, 8}, { 1, 7}, { 1, 7}, { 2, 7}, { 1, 8}, { 1, 7},
+	{ 0, 0}, { 4, 8}, { 2,11}, { 4, 8}, { 4, 8}, { 3, 9}, { 4, 8}, { 4, 8},
+	{ 4, 8}, { 3, 9}, { 3,10}, { 2,11}, { 5, 6}, { 3,10}, { 1,12}, { 2,11},
+	{ 3, 9}, { 5, 7}, { 4, 8}, { 4, 8}, { 0, 0}, { 4, 8}, { 2,11}, { 4, 9},
+	{ 4, 8}, { 3,10}, { 4, 7}, { 4, 8}, { 4, 8}, { 3, 9}, { 3,10}, { 2,11},
+	{ 5, 6}, { 3,10}, { 2,11}, { 2,11}, { 3, 9}, { 5, 7}, { 4, 8}, { 4, 8},
+};
+
+const PROGMEM unsigned char FONT_HANBOOT2_EXT[88][2] = {
+	{ 0, 0}, {10, 6}, { 9, 6}, {10, 6}, { 9, 6}, { 9, 5}, { 7, 8}, { 8, 6},
+	{ 8, 7}, { 3,12}, { 1,15}, { 1,14}, { 1,13}, { 1,14}, { 1,11}, { 1,13},
+	{ 1,14}, { 1,13}, { 1,11}, { 1,14}, { 1,13}, {11, 3}, { 0, 0}, {10, 6},
+	{ 9, 6}, {10, 6}, { 9, 6}, { 8, 6}, { 7, 8}, { 8, 6}, { 7, 8}, { 1,14},
+	{ 1,15}, { 1,14}, { 1,13}, { 1,14}, { 1,11}, { 1,13}, { 1,14}, { 1,13},
+	{ 1,11}, { 1,14}, { 1,13}, {11, 3}, { 0, 0}, {10, 6}, { 9, 6}, {10, 6},
+	{ 9, 6}, { 9, 5}, { 7, 8}, { 9, 5}, { 8, 7}, { 1,14}, { 1,15}, { 1,14},
+	{ 1,13}, { 1,14}, { 1,11}, { 1,13}, { 1,14}, { 1,13}, { 1,11}, { 1,14},
+	{ 1,13}, {11, 3}, { 0, 0}, {10, 6}, { 9, 6}, {10, 6}, { 9, 6}, { 9, 5},
+	{ 7, 8}, { 9, 5}, { 8, 7}, { 1,14}, { 1,15}, { 1,14}, { 1,13}, { 1,14},
+	{ 1,11}, { 1,13}, { 1,14}, { 1,13}, { 1,11}, { 1,14}, { 1,13}, {11, 3},
+};
+
+const PROGMEM unsigned char FONT_HANBOOT3_EXT[112][2] = {
+	{ 0, 0}, { 5, 8}, { 3,10}, { 3,11}, { 5, 8}, { 3,12}, { 3,11}, { 4, 9},
+	{ 5, 8}, { 4,10}, { 4,10}, { 4,10}, { 4,11}, { 4,10}, { 4,10}, { 4,10},
+	{ 5, 8}, { 5, 8}, { 4,11}, { 4, 9}, { 3,11}, { 6, 7}, { 4, 9}, { 4, 9},
+	{ 5, 8}, { 5, 8}, { 4,10}, { 5, 8}, { 0, 0}, { 5, 9}, { 4,10}, { 4,11},
+	{ 7, 8}, { 4,12}, { 4,11}, { 5, 9}, { 6, 8}, { 5,10}, { 5,10}, { 5,10},
+	{ 5,11}, { 5,10}, { 5,10}, { 5,10}, { 6, 8}, { 6, 8}, { 5,11}, { 5, 9},
+	{ 4,11}, { 7, 7}, { 5, 9}, { 5, 9}, { 6, 8}, { 6, 8}, { 6, 9}, { 6, 8},
+	{ 0, 0}, { 5, 9}, { 5,10}, { 5,11}, { 7, 8}, { 4,12}, { 4,11}, { 6, 9},
+	{ 6, 8}, { 5,10}, { 5,10}, { 5,10}, { 5,11}, { 5,10}, { 5,10}, { 5,10},
+	{ 6, 8}, { 6, 8}, { 5,11}, { 6, 9}, { 4,11}, { 7, 7}, { 6, 9}, { 6, 9},
+	{ 6, 8}, { 6, 9}, { 6, 9}, { 7, 8}, { 0, 0}, { 4, 8}, { 3,10}, { 3,11},
+	{ 5, 8}, { 3,11}, { 3,10}, { 4, 9}, { 4, 9}, { 4, 9}, { 3,10}, { 3,10},
+	{ 3,11}, { 3,11}, { 3,10}, { 4,10}, { 4, 8}, { 4, 8}, { 3,11}, { 3, 9},
+	{ 2,11}, { 5, 7}, { 4, 9}, { 4, 9}, { 4, 9}, { 4, 9}, { 4, 9}, { 4, 8},
+};
+
+const PROGMEM unsigned char FONT_HANGODIC1_EXT[160][2] = {
+	{ 0, 0}, { 1, 6}, { 1, 7}, { 1, 8}, { 1, 8}, { 1, 9}, { 1, 8}, { 1, 7},
+	{ 1, 7}, { 1, 8}, { 1, 8}, { 0, 9}, { 1, 8}, { 1, 8}, { 0, 9}, { 1, 8},
+	{ 1, 6}, { 1, 8}, { 1, 7}, { 1, 8}, { 0, 0}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 0, 0}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 0, 0}, { 1, 8}, { 1, 8}, { 1, 8},
+	{ 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 0, 9},
+	{ 1, 8}, { 1, 8}, { 1, 9}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8},
+	{ 0, 0}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8},
+	{ 1, 8}, { 1, 8}, { 1, 8}, { 0, 9}, { 1, 8}, { 1, 8}, { 1, 9}, { 1, 8},
+	{ 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 0, 0}, { 1, 6}, { 1, 8}, { 1, 8},
+	{ 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 0, 9},
+	{ 1, 8}, { 1, 8}, { 1, 9}, { 1, 8}, { 1, 7}, { 1, 8}, { 1, 8}, { 1, 8},
+	{ 0, 0}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 0, 0}, { 1, 8}, { 1, 8}, { 1, 8},
+	{ 2, 7}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 0, 9},
+	{ 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8},
+};
+
+const PROGMEM unsigned char FONT_HANGODIC2_EXT[88][2] = {
+	{ 0, 0}, {11, 5}, {10, 5}, {11, 5}, {10, 5}, { 9, 5}, { 8, 7}, { 9, 5},
+	{ 8, 7}, { 1,14}, { 1,15}, { 1,14}, { 1,13}, { 1,14}, { 1,14}, { 1,13},
+	{ 1,14}, { 1,13}, { 1,14}, { 1,14}, { 1,13}, {12, 2}, { 0, 0}, {11, 5},
+	{10, 5}, {11, 5}, {10, 5}, { 9, 5}, { 8, 7}, { 9, 5}, { 8, 7}, { 1,14},
+	{ 1,15}, { 1,14}, { 1,13}, { 1,14}, { 1,14}, { 1,13}, { 1,14}, { 1,13},
+	{ 1,14}, { 1,14}, { 1,13}, {12, 2}, { 0, 0}, {11, 5}, {10, 5}, {11, 5},
+	{10, 5}, { 9, 5}, { 8, 7}, { 9, 5}, { 8, 7}, { 1,14}, { 1,15}, { 1,14},
+	{ 1,13}, { 1,14}, { 1,14}, { 1,13}, { 1,14}, { 1,13}, { 1,14}, { 1,14},
+	{ 1,13}, {12, 2}, { 0, 0}, {11, 5}, {10, 5}, {11, 5}, {10, 5}, { 9, 5},
+	{ 8, 7}, { 9, 5}, { 8, 7}, { 1,14}, { 1,15}, { 1,14}, { 1,13}, { 1,14},
+	{ 1,14}, { 1,13}, { 1,14}, { 1,13}, { 1,14}, { 1,14}, { 1,13}, {12, 2},
+};
+
+const PROGMEM unsigned char FONT_HANGODIC3_EXT[112][2] = {
+	{ 0, 0}, { 3,10}, { 3,10}, { 3,12}, { 3,10}, { 3,10}, { 3,10}, { 3,10},
+	{ 3,10}, { 3,10}, { 3,10}, { 3,10}, { 3,11}, { 3,10}, { 3,10}, { 3,10},
+	{ 3,10}, { 3,10}, { 3,11}, { 3,10}, { 3,11}, { 3,10}, { 3,10}, { 3,10},
+	{ 3,10}, { 3,10}, { 3,10}, { 3,10}, { 0, 0}, { 4,10}, { 4,10}, { 4,12},
+	{ 4,10}, { 4,10}, { 4,10}, { 4,10}, { 4,10}, { 4,10}, { 4,10}, { 4,10},
+	{ 4,11}, { 4,10}, { 4,10}, { 4,10}, { 4,10}, { 4,10}, { 4,11}, { 4,10},
+	{ 4,11}, { 4,10}, { 4,10}, { 4,10}, { 4,10}, { 4,10}, { 4,10}, { 4,10},
+	{ 0, 0}, { 3,12}, { 3,12}, { 3,12}, { 3,12}, { 3,12}, { 3,12}, { 3,12},
+	{ 3,12}, { 3,12}, { 3,12}, { 3,12}, { 3,12}, { 3,12}, { 3,12}, { 3,12},
+	{ 3,12}, { 3,12}, { 3,12}, { 3,12}, { 3,12}, { 3,12}, { 3,12}, { 3,12},
+	{ 3,12}, { 3,12}, { 3,12}, { 3,12}, { 0, 0}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+};
+
+const PROGMEM unsigned char FONT_HANPIL1_EXT[160][2] = {
+	{ 0, 0}, { 1, 8}, { 1, 8}, { 1, 9}, { 1, 8}, { 1, 8}, { 2, 7}, { 1, 8},
+	{ 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 2, 7}, { 1, 8}, { 1, 8}, { 1, 8},
+	{ 1, 8}, { 1, 8}, { 1, 9}, { 1, 8}, { 0, 0}, { 4, 9}, { 4, 9}, { 4, 9},
+	{ 4, 9}, { 3,10}, { 5, 7}, { 4, 8}, { 4, 9}, { 4,10}, { 4, 9}, { 3,11},
+	{ 5, 7}, { 4, 9}, { 3,11}, { 4, 9}, { 4, 9}, { 5, 8}, { 4,10}, { 4, 9},
+	{ 0, 0}, { 4, 9}, { 4, 9}, { 4, 9}, { 4, 9}, { 4, 9}, { 5, 7}, { 4, 8},
+	{ 4, 9}, { 4,10}, { 4, 9}, { 3,11}, { 5, 7}, { 5, 8}, { 3,11}, { 4, 9},
+	{ 4, 9}, { 5, 7}, { 4, 9}, { 5, 7}, { 0, 0}, { 1, 9}, { 2, 8}, { 2, 9},
+	{ 2, 9}, { 2, 9}, { 3, 8}, { 2, 8}, { 2, 8}, { 2, 8}, { 2, 8}, { 1, 9},
+	{ 4, 6}, { 3, 7}, { 2, 8}, { 3, 7}, { 3, 7}, { 3, 8}, { 3, 8}, { 3, 7},
+	{ 0, 0}, { 2, 8}, { 2, 7}, { 2, 9}, { 2, 9}, { 2, 9}, { 2, 8}, { 2, 8},
+	{ 2, 8}, { 2, 8}, { 2, 8}, { 1, 9}, { 3, 6}, { 2, 8}, { 1, 9}, { 3, 7},
+	{ 2, 7}, { 2, 8}, { 2, 8}, { 2, 7}, { 0, 0}, { 2, 7}, { 1, 8}, { 2, 8},
+	{ 2, 8}, { 1, 9}, { 2, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 2, 8}, { 1, 8},
+	{ 2, 7}, { 1, 8}, { 1, 8}, { 1, 8}, { 2, 7}, { 2, 8}, { 2, 8}, { 2, 8},
+	{ 0, 0}, { 4, 9}, { 4, 9}, { 4, 9}, { 4, 8}, { 4, 9}, { 5, 7}, { 4, 9},
+	{ 4, 9}, { 4, 9}, { 4, 9}, { 3,11}, { 5, 7}, { 4, 8}, { 3,10}, { 4, 9},
+	{ 4, 9}, { 5, 7}, { 4, 9}, { 4, 9}, { 0, 0}, { 2, 7}, { 2, 7}, { 2, 7},
+	{ 2, 7}, { 2, 7}, { 2, 7}, { 2, 7}, { 2, 7}, { 2, 7}, { 2, 7}, { 2, 7},
+	{ 3, 6}, { 2, 7}, { 2, 7}, { 2, 7}, { 2, 7}, { 2, 7}, { 2, 8}, { 2, 7},
+};
+
+const PROGMEM unsigned char FONT_HANPIL2_EXT[88][2] = {
+	{ 0, 0}, {11, 5}, {10, 6}, {11, 5}, { 9, 6}, { 9, 5}, { 9, 7}, {10, 4},
+	{ 9, 7}, { 1,15}, { 1,15}, { 1,15}, { 1,12}, { 1,15}, { 1,15}, { 1,12},
+	{ 1,15}, { 1,12}, { 1,15}, { 1,15}, { 1,12}, {11, 3}, { 0, 0}, {11, 5},
+	{10, 6}, {11, 5}, { 9, 6}, { 9, 5}, { 9, 7}, {10, 4}, {10, 6}, { 1,15},
+	{ 1,15}, { 1,15}, { 1,13}, { 1,15}, { 1,15}, { 1,13}, { 1,15}, { 1,12},
+	{ 1,15}, { 1,15}, { 1,12}, {11, 3}, { 0, 0}, {11, 5}, {10, 6}, {11, 5},
+	{10, 6}, {10, 4}, {10, 6}, {10, 4}, {10, 6}, { 1,15}, { 1,15}, { 1,15},
+	{ 1,12}, { 1,15}, { 1,15}, { 1,13}, { 1,15}, { 1,12}, { 1,15}, { 1,15},
+	{ 1,12}, {11, 3}, { 0, 0}, {11, 5}, {10, 6}, {11, 5}, {10, 6}, {10, 5},
+	{10, 6}, {11, 4}, {10, 6}, { 1,15}, { 1,15}, { 1,15}, { 1,12}, { 1,15},
+	{ 1,15}, { 1,13}, { 1,15}, { 1,12}, { 1,15}, { 1,15}, { 1,12}, {11, 3},
+};
+
+const PROGMEM unsigned char FONT_HANPIL3_EXT[112][2] = {
+	{ 0, 0}, { 4, 9}, { 4, 9}, { 1,13}, { 4, 9}, { 2,12}, { 1,13}, { 5, 9},
+	{ 5, 8}, { 2,11}, { 2,11}, { 2,11}, { 2,12}, { 2,11}, { 2,12}, { 2,12},
+	{ 4, 9}, { 5, 8}, { 2,12}, { 3,12}, { 2,13}, { 6, 7}, { 3,12}, { 3,12},
+	{ 4, 9}, { 4, 9}, { 4,10}, { 4, 9}, { 0, 0}, { 5, 9}, { 3,11}, { 1,14},
+	{ 4,10}, { 3,12}, { 1,14}, { 5, 9}, { 6, 8}, { 2,13}, { 2,12}, { 2,12},
+	{ 2,13}, { 2,13}, { 2,13}, { 2,13}, { 5, 9}, { 6, 8}, { 2,13}, { 4,12},
+	{ 2,13}, { 7, 7}, { 4,12}, { 4,12}, { 5, 9}, { 5, 9}, { 5,10}, { 5, 9},
+	{ 0, 0}, { 5,10}, { 5,10}, { 1,15}, { 4,11}, { 3,13}, { 1,14}, { 5,10},
+	{ 6, 9}, { 2,13}, { 2,13}, { 2,13}, { 2,14}, { 2,13}, { 2,13}, { 2,14},
+	{ 6, 9}, { 7, 8}, { 3,13}, { 4,12}, { 1,15}, { 8, 7}, { 4,12}, { 4,12},
+	{ 5,10}, { 5,10}, { 5,10}, { 6, 9}, { 0, 0}, { 4, 8}, { 3, 9}, { 1,13},
+	{ 3, 9}, { 2,12}, { 1,13}, { 3, 8}, { 5, 7}, { 3,10}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 4, 8}, { 4, 8}, { 2,12}, { 3,12},
+	{ 2,13}, { 5, 7}, { 3,12}, { 3,12}, { 4, 8}, { 5, 8}, { 5, 8}, { 4,10},
+};
+
+const PROGMEM unsigned char FONT_HANSOFT1_EXT[160][2] = {
+	{ 0, 0}, { 1, 6}, { 1, 7}, { 1, 8}, { 1, 7}, { 1, 8}, { 1, 7}, { 1, 7},
+	{ 1, 7}, { 1, 8}, { 1, 8}, { 0, 9}, { 1, 8}, { 1, 8}, { 0, 9}, { 1, 8},
+	{ 1, 6}, { 1, 7}, { 1, 7}, { 1, 8}, { 0, 0}, { 2,12}, { 1,13}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 0, 0}, { 2,12}, { 1,13}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 0, 0}, { 1, 8}, { 1, 8}, { 1, 8},
+	{ 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 0, 9},
+	{ 1, 8}, { 1, 8}, { 1, 9}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8},
+	{ 0, 0}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8},
+	{ 1, 8}, { 1, 8}, { 1, 8}, { 0, 9}, { 1, 8}, { 1, 8}, { 1, 9}, { 1, 8},
+	{ 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 0, 0}, { 1, 8}, { 1, 8}, { 1, 8},
+	{ 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 0, 9},
+	{ 1, 8}, { 1, 8}, { 1, 9}, { 1, 8}, { 1, 7}, { 1, 8}, { 1, 8}, { 1, 8},
+	{ 0, 0}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 0, 0}, { 1, 8}, { 1, 8}, { 1, 8},
+	{ 2, 7}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 0, 9},
+	{ 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8}, { 1, 8},
+};
+
+const PROGMEM unsigned char FONT_HANSOFT2_EXT[88][2] = {
+	{ 0, 0}, {11, 5}, {10, 5}, {11, 5}, {10, 5}, { 9, 5}, { 8, 7}, { 9, 5},
+	{ 8, 7}, { 1,14}, { 1,15}, { 1,14}, { 1,13}, { 1,14}, { 1,14}, { 1,13},
+	{ 1,14}, { 1,13}, { 1,14}, { 1,14}, { 1,13}, {12, 2}, { 0, 0}, {11, 5},
+	{10, 5}, {11, 5}, {10, 5}, { 9, 5}, { 8, 7}, { 9, 5}, { 8, 7}, { 1,14},
+	{ 1,15}, { 1,14}, { 1,13}, { 1,14}, { 1,14}, { 1,13}, { 1,14}, { 1,13},
+	{ 1,14}, { 1,14}, { 1,13}, {12, 2}, { 0, 0}, {11, 5}, {10, 5}, {11, 5},
+	{10, 5}, { 9, 5}, { 8, 7}, { 9, 5}, { 8, 7}, { 1,14}, { 1,15}, { 1,14},
+	{ 1,13}, { 1,14}, { 1,14}, { 1,13}, { 1,14}, { 1,13}, { 1,14}, { 1,14},
+	{ 1,13}, {12, 2}, { 0, 0}, {11, 5}, {10, 5}, {11, 5}, {10, 5}, { 9, 5},
+	{ 8, 7}, { 9, 5}, { 8, 7}, { 1,14}, { 1,15}, { 1,14}, { 1,13}, { 1,14},
+	{ 1,14}, { 1,13}, { 1,14}, { 1,13}, { 1,14}, { 1,14}, { 1,13}, {12, 2},
+};
+
+const PROGMEM unsigned char FONT_HANSOFT3_EXT[112][2] = {
+	{ 0, 0}, { 2,11}, { 2,11}, { 2,13}, { 2,11}, { 2,11}, { 2,11}, { 2,11},
+	{ 2,11}, { 2,11}, { 2,11}, { 2,11}, { 2,12}, { 2,11}, { 2,11}, { 2,11},
+	{ 2,11}, { 2,11}, { 2,12}, { 1,12}, { 2,12}, { 2,11}, { 1,12}, { 1,12},
+	{ 2,11}, { 2,11}, { 2,11}, { 2,11}, { 0, 0}, { 2,12}, { 2,12}, { 2,13},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,13}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,13}, { 2,12},
+	{ 2,13}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 0, 0}, { 2,13}, { 2,13}, { 2,13}, { 2,13}, { 2,13}, { 2,13}, { 2,13},
+	{ 2,13}, { 2,13}, { 2,13}, { 2,13}, { 2,13}, { 2,13}, { 2,13}, { 2,13},
+	{ 2,13}, { 2,13}, { 2,13}, { 2,13}, { 2,13}, { 2,13}, { 2,13}, { 2,13},
+	{ 2,13}, { 2,13}, { 2,13}, { 2,13}, { 0, 0}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+	{ 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12}, { 2,12},
+};
+
+#endif  // __FONT_METRICS_H__
+//-----------------------------------------------------------------------------
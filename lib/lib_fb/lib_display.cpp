@@ -0,0 +1,109 @@
+//-----------------------------------------------------------------------------
+/**
+ * @file lib_display.cpp
+ * @author charles-park (charles-park@hardkernel.com)
+ * @brief Display sink interface (lib_fb -> MAX7219, HT16K33, virtual panel)
+ * @version 0.1
+ * @date 2023-06-22
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//-----------------------------------------------------------------------------
+#include <lib_fb.h>
+#include <lib_display.h>
+
+//-----------------------------------------------------------------------------
+void lib_display::blit (const lib_fb &fb, int x_off, int y_off, bool x_wrap)
+{
+    unsigned char *p_buf = get_buffer ();
+    int w = get_width (), h = get_height ();
+
+    /* same layout : 8 pixels at a time */
+    if (p_buf && (get_format () == DISP_FMT_ROW1_LSB) && (fb.get_bpp () == 1)) {
+        int stride = get_buffer_stride ();
+
+        for (int y = 0; y < h; y++, p_buf += stride) {
+            int fy = y_off + y;
+
+            for (int j = 0; j < (w + 7) / 8; j++) {
+                if ((fy < 0) || (fy >= fb.get_height ()))
+                    p_buf[j] = 0;
+                else
+                    p_buf[j] = x_wrap ? fb.get_byte_wrap (x_off + j * 8, fy) :
+                                        fb.get_byte (x_off + j * 8, fy);
+            }
+        }
+        return;
+    }
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int fx = x_off + x, fy = y_off + y;
+            bool onoff;
+
+            if (x_wrap)
+                fx = ((fx % fb.get_width ()) + fb.get_width ()) % fb.get_width ();
+            onoff = (fx >= 0) && (fy >= 0) &&
+                        (fx < fb.get_width ()) && (fy < fb.get_height ()) &&
+                        fb.get_pixel (fx, fy);
+            set_pixel (x, y, onoff);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void lib_display::blit_region (const lib_fb &fb, int x_off, int y_off,
+                                const struct disp_region *p_region)
+{
+    unsigned char *p_buf = get_buffer ();
+    struct disp_region r = *p_region;
+
+    align_region (&r);
+    if (!r.w || !r.h)
+        return;
+
+    if (p_buf && (get_format () == DISP_FMT_ROW1_LSB) && (fb.get_bpp () == 1)) {
+        int stride = get_buffer_stride ();
+
+        for (int y = r.y; y < r.y + r.h; y++) {
+            int fy = y_off + y;
+
+            for (int j = r.x / 8; j < (r.x + r.w + 7) / 8; j++)
+                p_buf[y * stride + j] = ((fy >= 0) && (fy < fb.get_height ())) ?
+                                            fb.get_byte (x_off + j * 8, fy) : 0;
+        }
+        return;
+    }
+
+    for (int y = r.y; y < r.y + r.h; y++) {
+        for (int x = r.x; x < r.x + r.w; x++) {
+            int fx = x_off + x, fy = y_off + y;
+
+            set_pixel (x, y, (fx >= 0) && (fy >= 0) &&
+                        (fx < fb.get_width ()) && (fy < fb.get_height ()) &&
+                        fb.get_pixel (fx, fy));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void lib_display::align_region (struct disp_region *p_region) const
+{
+    int xa = get_x_align (), ya = get_y_align ();
+    int x0 = p_region->x, y0 = p_region->y;
+    int x1 = p_region->x + p_region->w, y1 = p_region->y + p_region->h;
+
+    x0 = (x0 < 0) ? 0 : (x0 / xa) * xa;
+    y0 = (y0 < 0) ? 0 : (y0 / ya) * ya;
+    x1 = ((x1 + xa - 1) / xa) * xa;
+    y1 = ((y1 + ya - 1) / ya) * ya;
+    if (x1 > get_width ())     x1 = get_width ();
+    if (y1 > get_height ())    y1 = get_height ();
+
+    p_region->x = x0;   p_region->w = (x1 > x0) ? (x1 - x0) : 0;
+    p_region->y = y0;   p_region->h = (y1 > y0) ? (y1 - y0) : 0;
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
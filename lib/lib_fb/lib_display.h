@@ -0,0 +1,79 @@
+//-----------------------------------------------------------------------------
+/**
+ * @file lib_display.h
+ * @author charles-park (charles-park@hardkernel.com)
+ * @brief Display sink interface (lib_fb -> MAX7219, HT16K33, virtual panel)
+ * @version 0.1
+ * @date 2023-06-22
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Each display declares its native pixel layout and transfer unit.
+ * lib_fb::present() copies with the matching blit path and sends the region.
+ *
+ *  lib_fb      fb (1920, 16, 1);
+ *  lib_matrix  matrix (128, 16, MatrixMap);
+ *  fb.present (matrix, x_offset, 0);
+ */
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+#ifndef __LIB_DISPLAY_H__
+#define __LIB_DISPLAY_H__
+
+//-----------------------------------------------------------------------------
+// Native pixel layout of the display buffer
+//-----------------------------------------------------------------------------
+// 1bpp row major, LSB first (x = 0 is bit 0). same as lib_fb 1bpp.
+#define DISP_FMT_ROW1_LSB       0
+// 8x8 modules, one byte per module line, MSB first. (MAX7219 digit register)
+#define DISP_FMT_MODULE8_MSB    1
+
+//-----------------------------------------------------------------------------
+struct disp_region {
+    int x, y, w, h;
+};
+
+class lib_fb;
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+class lib_display
+{
+public:
+    virtual ~lib_display () {};
+
+    virtual int get_width  () const = 0;
+    virtual int get_height () const = 0;
+    // DISP_FMT_xxx
+    virtual int get_format () const = 0;
+    // transfer unit (dots). present regions are aligned to it.
+    virtual int get_x_align () const { return 1; }
+    virtual int get_y_align () const { return 1; }
+
+    // display buffer of the native format. (NULL : not directly writable)
+    virtual unsigned char *get_buffer () { return NULL; }
+    virtual int get_buffer_stride () const { return 0; }
+
+    virtual void set_pixel (int x, int y, bool onoff) = 0;
+
+    // copy fb(x_off, y_off) ~ (x_off + width, y_off + height) to display buffer.
+    // out of range area of framebuffer is filled with 0.
+    // x_wrap : x wraps around the fb width. (ring framebuffer)
+    // default : ROW1_LSB buffer byte copy, otherwise per pixel copy.
+    virtual void blit (const lib_fb &fb, int x_off, int y_off, bool x_wrap = false);
+    // blit the display region (display coordinates) only. (lib_fb::present_dirty)
+    // default : ROW1_LSB buffer bytes of the region, otherwise per pixel copy.
+    virtual void blit_region (const lib_fb &fb, int x_off, int y_off,
+                                const struct disp_region *p_region);
+
+    // send the display buffer. p_region = NULL : whole display
+    virtual void present (const struct disp_region *p_region = NULL) = 0;
+
+    // expand the region to the transfer unit and clip to the display
+    void align_region (struct disp_region *p_region) const;
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+#endif  // #define __LIB_DISPLAY_H__
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
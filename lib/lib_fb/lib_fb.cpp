@@ -12,7 +12,12 @@
 //-----------------------------------------------------------------------------
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <wchar.h>
+#include <math.h>
 #include <lib_fb.h>
+#include "fonts/FontScale.h"
 
 //-----------------------------------------------------------------------------
 lib_fb::lib_fb (int w, int h, int bpp,
@@ -26,6 +31,9 @@ lib_fb::lib_fb (int w, int h, int bpp,
     _size   = (_h * _stride);
 
     set_color (fg_color, bg_color);
+    _clip_cnt = 0;  _scale = 1;     _transparent = false;   _proportional = false;
+    _dirty_cnt = 0;
+    reset_clip ();
 
     _p_mem = new unsigned char [_size];
 }
@@ -40,131 +48,866 @@ lib_fb::~lib_fb ()
 //-----------------------------------------------------------------------------
 void lib_fb::put_pixel (int x, int y, unsigned int color)
 {
-    if ((x >= _w) || (y >= _h)) {
-        printf ("%s(%s):Out of range.(width = %d, x = %d, height = %d, y = %d)\r\n",
-            __FILE__, __func__, _w, x, _h, y);
+    if ((x < _clip.x0) || (x >= _clip.x1) || (y < _clip.y0) || (y >= _clip.y1)) {
+        _clip_cnt++;
         return;
     }
-    if ((_bpp == 32) || (_bpp == 24)) {
-        int offset = (y * _stride) + (x * (_bpp >> 3));
-        union u_color888 c;
-        c.ui = color;
+    _add_dirty (x, y, 1, 1);
+    switch (_bpp) {
+        case 32:    put_pixel32 (x, y, color);  break;
+        case 24:    put_pixel24 (x, y, color);  break;
+        case 16:    put_pixel16 (x, y, color);  break;
+        default:    put_pixel1  (x, y, color);  break;
+    }
+}
 
-        _p_mem[offset+0] = c.ub[0]; _p_mem[offset+1] = c.ub[1];
-        _p_mem[offset+2] = c.ub[2]; _p_mem[offset+3] = c.ub[3];
-    } else if (_bpp == 16) {
-        int offset = (y * _stride) + (x * (_bpp >> 3));
-        union u_color565 c;
-        c.us = (unsigned short)color;
+//-----------------------------------------------------------------------------
+unsigned int lib_fb::get_pixel (int x, int y) const
+{
+    if (((unsigned int)x >= (unsigned int)_w) || ((unsigned int)y >= (unsigned int)_h)) {
+        _clip_cnt++;
+        return 0;
+    }
 
-        _p_mem[offset+0] = c.ub[0]; _p_mem[offset+1] = c.ub[1];
-    } else {
-        int offset = (y * _stride) + (x / 8), bit_offset = x % 8;
+    switch (_bpp) {
+        case 32:    return  get_pixel32 (x, y);
+        case 24:    return  get_pixel24 (x, y);
+        case 16:    return  get_pixel16 (x, y);
+        default:    return  get_pixel1  (x, y);
+    }
+}
 
-        if (color)  _p_mem[offset] |= ( (0x01 << bit_offset));
-        else        _p_mem[offset] &= (~(0x01 << bit_offset));
+//-----------------------------------------------------------------------------
+// font image(MSB first) <-> 1bpp framebuffer(LSB first) bit order
+//
+static inline unsigned int _bit_reverse (unsigned int b)
+{
+    b = ((b & 0xF0) >> 4) | ((b & 0x0F) << 4);
+    b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
+    b = ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
+    return  b;
+}
+
+//-----------------------------------------------------------------------------
+// 1bpp : nbits(1 ~ 24) glyph pixels (LSB = x) of line y at once.
+// glyph bit 1 = fg_color, 0 = bg_color (transparent : not drawn)
+//
+void lib_fb::_put_row1 (int x, int y, unsigned int bits, int nbits)
+{
+    unsigned int mask = (1u << nbits) - 1, set, write;
+    unsigned char *p_mem;
+    int shift;
+
+    /* clip x */
+    if (x < _clip.x0) {
+        int cut = _clip.x0 - x;
+
+        if (cut >= nbits)
+            return;
+        bits >>= cut;   mask >>= cut;   nbits -= cut;   x = _clip.x0;
+    }
+    if (x + nbits > _clip.x1) {
+        if (x >= _clip.x1)
+            return;
+        nbits = _clip.x1 - x;
+        mask &= (1u << nbits) - 1;
     }
+    bits &= mask;
+    set   = (_fg_color ? bits : 0) | ((_bg_color && !_transparent) ? (~bits & mask) : 0);
+    write = _transparent ? bits : mask;
+
+    p_mem = &_p_mem[y * _stride + (x >> 3)];
+    shift = x & 7;
+    set <<= shift;  write <<= shift;
+    for (; write; write >>= 8, set >>= 8, p_mem++)
+        *p_mem = (*p_mem & ~write) | (set & write);
 }
 
 //-----------------------------------------------------------------------------
-unsigned int lib_fb::get_pixel (int x, int y)
+// glyph line byte (LSB = left dot) x scale. (scale 2 ~ 4 : PROGMEM table)
+//
+static inline unsigned long long _scale_byte (unsigned int b, int scale)
 {
-    if ((x >= _w) || (y >= _h)) {
-        printf ("%s(%s):Out of range.(width = %d, x = %d, height = %d, y = %d)\r\n",
-            __FILE__, __func__, _w, x, _h, y);
-        return 0;
+    unsigned long long v = 0;
+
+    switch (scale) {
+        case 1: return  b;
+        case 2: return  pgm_read_word  (&FONT_SCALE_X2[b]);
+        case 3: return  pgm_read_dword (&FONT_SCALE_X3[b]);
+        case 4: return  pgm_read_dword (&FONT_SCALE_X4[b]);
+        default:
+            for (int j = 7; j >= 0; j--) {
+                v <<= scale;
+                if ((b >> j) & 1)
+                    v |= (1ull << scale) - 1;
+            }
+            return  v;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// 1bpp row-parallel glyph blit. each glyph line is expanded once (x scale)
+// and written to its scale lines 24 bits at a time, lines are clipped once.
+//
+int lib_fb::_draw_bitmap1 (int x, int y, const unsigned char *p_img, int w, int h,
+                            int left, int cols)
+{
+    int stride = w / 8, sw = cols * _scale;
+
+    if ((x >= _clip.x1) || (x + sw <= _clip.x0) ||
+        (y >= _clip.y1) || (y + h * _scale <= _clip.y0))
+        return  sw;
+
+    for (int i = 0; i < h; i++) {
+        int py0 = y + i * _scale, py1 = py0 + _scale;
+        unsigned long long row;
+
+        if (py0 < _clip.y0)     py0 = _clip.y0;
+        if (py1 > _clip.y1)     py1 = _clip.y1;
+        if (py0 >= py1)
+            continue;
+
+        /* glyph line -> LSB first, x scale (seeded : no 64 bit shift when w * scale == 64) */
+        row = _scale_byte (_bit_reverse (p_img[i * stride + stride - 1]), _scale);
+        for (int j = stride - 2; j >= 0; j--)
+            row = (row << (8 * _scale)) | _scale_byte (_bit_reverse (p_img[i * stride + j]), _scale);
+        row >>= left * _scale;
+
+        for (int py = py0; py < py1; py++) {
+            for (int k = 0; k < sw; k += 24)
+                _put_row1 (x + k, py, (unsigned int)(row >> k) & 0xFFFFFF,
+                            (sw - k > 24) ? 24 : (sw - k));
+        }
     }
-    if ((_bpp == 32) || (_bpp == 24)) {
-        int offset = (y * _stride) + (x * (_bpp >> 3));
-        union u_color888 c;
+    return  sw;
+}
 
-        c.ub[0] = _p_mem[offset+0]; c.ub[1] = _p_mem[offset+1];
-        c.ub[2] = _p_mem[offset+2]; c.ub[3] = _p_mem[offset+3];
-        return c.ui;
-    } else if (_bpp == 16) {
-        int offset = (y * _stride) + (x * (_bpp >> 3));
-        union u_color565 c;
+//-----------------------------------------------------------------------------
+// Font image(MSB first, w / 8 bytes per line) columns left ~ (left + cols)
+// x scale at (x, y). Clipped once to the framebuffer, visible pixels are
+// written unchecked.
+//
+int lib_fb::_draw_bitmap (int x, int y, const unsigned char *p_img, int w, int h,
+                            int left, int cols)
+{
+    void (lib_fb::*put)(int, int, unsigned int);
+    int cx = x, cy = y, cw = cols * _scale, ch = h * _scale, stride = w / 8;
 
-        c.ub[0] = _p_mem[offset+0]; c.ub[1] = _p_mem[offset+1];
-        return (unsigned int)c.us;
-    } else {
-        int offset = (y * _stride) + (x / 8), bit_offset = x % 8;
+    if (!clip (&cx, &cy, &cw, &ch))
+        return  cols * _scale;
+    _add_dirty (cx, cy, cw, ch);
+
+    /* 1bpp : up to 64 dots wide glyph line */
+    if ((_bpp == 1) && (w * _scale <= 64))
+        return  _draw_bitmap1 (x, y, p_img, w, h, left, cols);
 
-        return  (_p_mem[offset] & (0x01 << bit_offset)) ? 1 : 0;
+    switch (_bpp) {
+        case 32:    put = &lib_fb::put_pixel32; break;
+        case 24:    put = &lib_fb::put_pixel24; break;
+        case 16:    put = &lib_fb::put_pixel16; break;
+        default:    put = &lib_fb::put_pixel1;  break;
     }
+    for (int py = cy; py < cy + ch; py++) {
+        const unsigned char *p_line = &p_img[((py - y) / _scale) * stride];
+
+        for (int px = cx; px < cx + cw; px++) {
+            int j = (px - x) / _scale + left;
+
+            if (p_line[j / 8] & (0x80 >> (j % 8)))
+                (this->*put) (px, py, _fg_color);
+            else if (!_transparent)
+                (this->*put) (px, py, _bg_color);
+        }
+    }
+    return  cols * _scale;
+}
+
+//-----------------------------------------------------------------------------
+int lib_fb::_draw_hangul_bitmap (int x, int y, int left, int cols)
+{
+    return  _draw_bitmap (x, y, get_hangul_img_p(),
+                            get_hangul_img_w(), get_hangul_img_h(), left, cols);
 }
 
 //-----------------------------------------------------------------------------
-int lib_fb::_draw_hangul_bitmap (int x, int y)
+int lib_fb::_draw_ascii_bitmap (int x, int y, int left, int cols)
 {
-    int i, j, x_off, y_off, scale_y, scale_x;
+    return  _draw_bitmap (x, y, get_ascii_img_p(),
+                            get_ascii_img_w(), get_ascii_img_h(), left, cols);
+}
+
+//-----------------------------------------------------------------------------
+// UTF-8 : hangul 3 bytes, others 1 byte. 0 = end of string (or broken char)
+//
+static inline int _char_bytes (const unsigned char *p_str)
+{
+    if (!p_str[0])
+        return  0;
+    if (p_str[0] >= 0x80)
+        return  (p_str[1] && p_str[2]) ? 3 : 0;
+    return  1;
+}
+
+//-----------------------------------------------------------------------------
+// drawn image columns of the char (before x scale), *p_left : first column.
+// fixed : cell width. proportional : ink + spacing inside the cell.
+//
+int lib_fb::_glyph_cols (const unsigned char *p_str, int bytes, int *p_left)
+{
+    int w = (bytes == 3) ? get_hangul_img_w() : get_ascii_img_w(), cols;
+
+    *p_left = 0;
+    if (!_proportional)
+        return  w;
+
+    if (bytes == 3)
+        get_hangul_extent (p_str[0], p_str[1], p_str[2], p_left, &cols);
+    else
+        get_ascii_extent (p_str[0], p_left, &cols);
+    /* blank glyph (space) */
+    if (!cols)
+        return  w / 2;
+
+    cols += FB_GLYPH_SPACING;
+    if (cols > w)
+        cols = w;
+    /* ink at the cell end : the spacing is taken before the ink */
+    if (*p_left + cols > w)
+        *p_left = w - cols;
+    return  cols;
+}
+
+//-----------------------------------------------------------------------------
+// width of the next char, *pp_str moves to the next char. (nothing is drawn)
+//
+int lib_fb::char_width (const char **pp_str)
+{
+    const unsigned char *p_str = (const unsigned char *)*pp_str;
+    int bytes = _char_bytes (p_str), left;
+
+    *pp_str += bytes;
+    if (!bytes)
+        return  0;
+    return  _glyph_cols (p_str, bytes, &left) * _scale;
+}
+
+//-----------------------------------------------------------------------------
+int lib_fb::text_width (const char *str)
+{
+    int width = 0, w;
+
+    while ((w = char_width (&str)) != 0)
+        width += w;
+    return  width;
+}
+
+//-----------------------------------------------------------------------------
+// draw the next char at (x, y), *pp_str moves to the next char.
+// return : draw width (0 = end of string)
+//
+int lib_fb::draw_char (int x, int y, const char **pp_str)
+{
+    const unsigned char *p_str = (const unsigned char *)*pp_str;
+    int bytes = _char_bytes (p_str), left, cols;
+
+    *pp_str += bytes;
+    if (!bytes)
+        return  0;
+    cols = _glyph_cols (p_str, bytes, &left);
+    //---------- 한글 ---------
+    /* 모든 문자는 기본적으로 UTF-8형태로 저장되며 한글은 3바이트를 가진다. */
+    /* 한글은 3바이트를 읽어 UTF8 to UTF16으로 변환후 초/중/종성을 분리하여 조합형으로 표시한다. */
+    if (bytes == 3) {
+        make_hangul_img (p_str[0], p_str[1], p_str[2]);
+        return  _draw_hangul_bitmap (x, y, left, cols);
+    }
+    //---------- ASCII 8x16 or ASCII 8x8(if scale is 0) ---------
+    make_ascii_img (p_str[0]);
+    return  _draw_ascii_bitmap (x, y, left, cols);
+}
+
+//-----------------------------------------------------------------------------
+int lib_fb::_draw_text  (int x, int y, unsigned char *p_str)
+{
+    const char *p_char = (const char *)p_str;
+    int draw_bits_total = 0, draw_bits = 0;
+
+    while (_scale && (draw_bits = draw_char (x, y, &p_char)) != 0) {
+        x += draw_bits;
+        draw_bits_total += draw_bits;
+    }
+    return (draw_bits_total);
+}
+
+//-----------------------------------------------------------------------------
+// Font image(MSB first, w <= 16) columns left ~ (left + cols) x scale -> columns.
+// each 8 x 8 block of the image is transposed once, x scale repeats the column,
+// y scale spreads the bits.
+//
+int lib_fb::_draw_columns (unsigned char *p_columns, int max_columns,
+                            const unsigned char *p_img, int w, int h, int left, int cols)
+{
+    unsigned long long column[16], mask;
+    int stride = w / 8, column_bytes = get_column_bytes (), n = 0;
+
+    if (stride > 2)
+        return  0;
+
+    mask = (_h < 64) ? ((1ull << _h) - 1) : ~0ull;
+    memset (column, 0, sizeof(column));
+    for (int band = 0; band < h / 8; band++) {
+        int shift = band * 8 * _scale;
+
+        if (shift >= 64)
+            break;
+        for (int j = 0; j < stride; j++) {
+            unsigned long long v = 0;
 
-    for (i = 0, y_off = 0; i < get_hangul_img_h(); i++) {
-        for (scale_y = 0; scale_y < _scale; scale_y++) {
-            for (x_off = 0, j = 0; j < get_hangul_img_w(); j++) {
-                for (scale_x = 0; scale_x < _scale; scale_x++) {
-                    unsigned int color = get_hangul_img_pixel(j, i) ?
-                                            _fg_color : _bg_color;
-                    put_pixel (x + x_off, y + y_off, color);
-                    x_off++;
+            for (int i = 0; i < 8; i++)
+                v |= (unsigned long long)p_img[(band * 8 + i) * stride + j] << (i * 8);
+            v = transpose8 (v);
+            /* byte k : image column (j * 8 + 7 - k), LSB = top line */
+            for (int k = 0; k < 8; k++)
+                column[j * 8 + 7 - k] |= _scale_byte ((v >> (k * 8)) & 0xFF, _scale) << shift;
+        }
+    }
+
+    for (int c = left; c < left + cols; c++) {
+        unsigned long long data = column[c] & mask;
+
+        for (int s = 0; (s < _scale) && (n < max_columns); s++, n++, p_columns += column_bytes) {
+            for (int b = 0; b < column_bytes; b++)
+                p_columns[b] = (b < 8) ? (unsigned char)(data >> (b * 8)) : 0;
+        }
+    }
+    return  n;
+}
+
+//-----------------------------------------------------------------------------
+int lib_fb::draw_text_columns (unsigned char *p_columns, int max_columns, const char *str)
+{
+    const unsigned char *p_str = (const unsigned char *)str;
+    int bytes, n = 0, column_bytes = get_column_bytes ();
+
+    while (_scale && (n < max_columns) && (bytes = _char_bytes (p_str)) != 0) {
+        unsigned char *p_dst = p_columns + n * column_bytes;
+        int left, cols = _glyph_cols (p_str, bytes, &left);
+
+        if (bytes == 3) {
+            make_hangul_img (p_str[0], p_str[1], p_str[2]);
+            n += _draw_columns (p_dst, max_columns - n, get_hangul_img_p(),
+                                get_hangul_img_w(), get_hangul_img_h(), left, cols);
+        } else {
+            make_ascii_img (p_str[0]);
+            n += _draw_columns (p_dst, max_columns - n, get_ascii_img_p(),
+                                get_ascii_img_w(), get_ascii_img_h(), left, cols);
+        }
+        p_str += bytes;
+    }
+    return  n;
+}
+
+//-----------------------------------------------------------------------------
+// 8 lines x 8 columns are transposed at once. (1bpp : get_byte)
+//
+void lib_fb::get_columns (unsigned char *p_columns, int x, int w) const
+{
+    int column_bytes = get_column_bytes ();
+
+    for (int g = 0; g < w; g += 8) {
+        for (int band = 0; band < column_bytes; band++) {
+            unsigned long long v = 0;
+
+            for (int i = 0; i < 8; i++) {
+                int y = band * 8 + i;
+                unsigned int data = 0;
+
+                if (y >= _h)
+                    break;
+                if (_bpp == 1)
+                    data = get_byte (x + g, y);
+                else {
+                    for (int k = 0; k < 8; k++)
+                        data |= get_pixel (x + g + k, y) ? (1 << k) : 0;
                 }
+                v |= (unsigned long long)data << (i * 8);
+            }
+            v = transpose8 (v);
+            /* byte k : column (x + g + k) */
+            for (int k = 0; (k < 8) && (g + k < w); k++)
+                p_columns[(g + k) * column_bytes + band] = (unsigned char)(v >> (k * 8));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Raster op of the 1bpp lines. dots are handled 32 at a time (LSB first word),
+// the destination is byte aligned after the head dots.
+//-----------------------------------------------------------------------------
+static inline unsigned long long _rop (unsigned long long d, unsigned long long s, int rop)
+{
+    switch (rop) {
+        case FB_ROP_OR:     return  d | s;
+        case FB_ROP_AND:    return  d & s;
+        case FB_ROP_XOR:    return  d ^ s;
+        case FB_ROP_CLEAR:  return  d & ~s;
+        default:            return  s;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// n (1 ~ 32) dots from x of the line. only the bytes holding them are read.
+//
+static inline unsigned int _get_bits (const unsigned char *p_line, int x, int n)
+{
+    const unsigned char *p;
+    int shift = x & 7, bytes = (shift + n + 7) >> 3;
+    unsigned long long v = 0;
+
+    if (!p_line)
+        return  0xFFFFFFFF;
+    p = p_line + (x >> 3);
+    for (int i = 0; i < bytes; i++)
+        v |= (unsigned long long)p[i] << (i * 8);
+    return  (unsigned int)(v >> shift);
+}
+
+//-----------------------------------------------------------------------------
+static inline void _rop_bits (unsigned char *p_line, int x, int n, unsigned int bits, int rop)
+{
+    unsigned char *p = p_line + (x >> 3);
+    int shift = x & 7, bytes = (shift + n + 7) >> 3;
+    unsigned long long d = 0, mask;
+
+    /* aligned word */
+    if (!shift && (n == 32)) {
+        unsigned int w = p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+
+        w = (unsigned int)_rop (w, bits, rop);
+        p[0] = w;   p[1] = w >> 8;  p[2] = w >> 16; p[3] = w >> 24;
+        return;
+    }
+    mask = (((1ull << n) - 1)) << shift;
+    for (int i = 0; i < bytes; i++)
+        d |= (unsigned long long)p[i] << (i * 8);
+    d = (d & ~mask) | (_rop (d, (unsigned long long)bits << shift, rop) & mask);
+    for (int i = 0; i < bytes; i++)
+        p[i] = (unsigned char)(d >> (i * 8));
+}
+
+//-----------------------------------------------------------------------------
+// p_src = NULL : all dots 1 (fill, invert)
+// backward : right to left (overlapped copy in the same line)
+//
+void lib_fb::_rop_row1 (unsigned char *p_dst, int dx, const unsigned char *p_src, int sx,
+                        int w, int rop, bool backward)
+{
+    int head = (dx & 7) ? 8 - (dx & 7) : 0, off;
+
+    if (head > w)
+        head = w;
+
+    if (!backward) {
+        if (head)
+            _rop_bits (p_dst, dx, head, _get_bits (p_src, sx, head), rop);
+        for (off = head; off < w; off += 32) {
+            int n = (w - off > 32) ? 32 : w - off;
+
+            _rop_bits (p_dst, dx + off, n, _get_bits (p_src, sx + off, n), rop);
+        }
+        return;
+    }
+    for (off = head + ((w - head + 31) / 32 - 1) * 32; off >= head; off -= 32) {
+        int n = (w - off > 32) ? 32 : w - off;
+
+        _rop_bits (p_dst, dx + off, n, _get_bits (p_src, sx + off, n), rop);
+    }
+    if (head)
+        _rop_bits (p_dst, dx, head, _get_bits (p_src, sx, head), rop);
+}
+
+//-----------------------------------------------------------------------------
+// clipped once. 1bpp : spans, otherwise unchecked per bpp.
+//
+void lib_fb::fill_rect (int x, int y, int w, int h, unsigned int color)
+{
+    if (!clip (&x, &y, &w, &h))
+        return;
+    _add_dirty (x, y, w, h);
+
+    if (_bpp == 1) {
+        for (int py = y; py < y + h; py++)
+            _rop_row1 (&_p_mem[py * _stride], x, NULL, 0, w,
+                        color ? FB_ROP_COPY : FB_ROP_CLEAR, false);
+        return;
+    }
+    for (int py = y; py < y + h; py++) {
+        for (int px = x; px < x + w; px++) {
+            switch (_bpp) {
+                case 32:    put_pixel32 (px, py, color);    break;
+                case 24:    put_pixel24 (px, py, color);    break;
+                default:    put_pixel16 (px, py, color);    break;
             }
-            y_off++;
         }
     }
-    return x_off;
 }
 
 //-----------------------------------------------------------------------------
-int lib_fb::_draw_ascii_bitmap (int x, int y)
+// 1bpp : xor spans, otherwise rgb bits are inverted (alpha is kept)
+//
+void lib_fb::invert_rect (int x, int y, int w, int h)
+{
+    unsigned int mask = (_bpp == 16) ? 0xFFFF : 0xFFFFFF;
+
+    if (!clip (&x, &y, &w, &h))
+        return;
+    _add_dirty (x, y, w, h);
+
+    for (int py = y; py < y + h; py++) {
+        if (_bpp == 1) {
+            _rop_row1 (&_p_mem[py * _stride], x, NULL, 0, w, FB_ROP_XOR, false);
+            continue;
+        }
+        for (int px = x; px < x + w; px++)
+            put_pixel (px, py, get_pixel (px, py) ^ mask);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void lib_fb::copy_rect (int dx, int dy, const lib_fb &src, int sx, int sy, int w, int h,
+                        int rop)
+{
+    bool same = (&src == this), bottom_up, backward;
+
+    /* src : framebuffer, dst : current clip */
+    if (sx < 0)         { dx -= sx;   w += sx;    sx = 0; }
+    if (sy < 0)         { dy -= sy;   h += sy;    sy = 0; }
+    if (dx < _clip.x0)  { sx += _clip.x0 - dx;    w -= _clip.x0 - dx;     dx = _clip.x0; }
+    if (dy < _clip.y0)  { sy += _clip.y0 - dy;    h -= _clip.y0 - dy;     dy = _clip.y0; }
+    if (sx + w > src._w)    w = src._w - sx;
+    if (sy + h > src._h)    h = src._h - sy;
+    if (dx + w > _clip.x1)  w = _clip.x1 - dx;
+    if (dy + h > _clip.y1)  h = _clip.y1 - dy;
+    if ((w <= 0) || (h <= 0) || (src._bpp != _bpp))
+        return;
+    _add_dirty (dx, dy, w, h);
+
+    /* overlapped area of the same fb : copy from the far side */
+    bottom_up = same && (dy > sy);
+    backward  = same && (dy == sy) && (dx > sx);
+
+    for (int i = 0; i < h; i++) {
+        int r = bottom_up ? (h - 1 - i) : i;
+
+        if (_bpp == 1) {
+            _rop_row1 (&_p_mem[(dy + r) * _stride], dx,
+                        &src._p_mem[(sy + r) * src._stride], sx, w, rop, backward);
+            continue;
+        }
+        for (int j = 0; j < w; j++) {
+            int c = backward ? (w - 1 - j) : j;
+
+            put_pixel (dx + c, dy + r, (unsigned int)_rop (get_pixel (dx + c, dy + r),
+                                    src.get_pixel (sx + c, sy + r), rop));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool lib_fb::push_clip (int x, int y, int w, int h)
+{
+    if (_clip_sp >= FB_CLIP_STACK)
+        return  false;
+
+    _clip_stack[_clip_sp++] = _clip;
+    /* empty intersection : nothing is drawn until pop_clip */
+    if (!clip (&x, &y, &w, &h))
+        w = h = 0;
+    _clip.x0 = x;   _clip.x1 = x + w;
+    _clip.y0 = y;   _clip.y1 = y + h;
+    return  true;
+}
+
+//-----------------------------------------------------------------------------
+void lib_fb::pop_clip ()
+{
+    if (_clip_sp)
+        _clip = _clip_stack[--_clip_sp];
+}
+
+//-----------------------------------------------------------------------------
+void lib_fb::reset_clip ()
+{
+    _clip.x0 = 0;   _clip.x1 = _w;
+    _clip.y0 = 0;   _clip.y1 = _h;
+    _clip_sp = 0;
+}
+
+//-----------------------------------------------------------------------------
+static inline struct disp_region _region_union (const struct disp_region *p_a,
+                                                const struct disp_region *p_b)
 {
-    int i, j, x_off = 0, y_off = 0, scale_y, scale_x;
+    struct disp_region r;
+    int x1 = (p_a->x + p_a->w > p_b->x + p_b->w) ? p_a->x + p_a->w : p_b->x + p_b->w;
+    int y1 = (p_a->y + p_a->h > p_b->y + p_b->h) ? p_a->y + p_a->h : p_b->y + p_b->h;
 
-    for (i = 0, y_off = 0; i < get_ascii_img_h(); i++) {
-        for (scale_y = 0; scale_y < _scale; scale_y++) {
-            for (x_off = 0, j = 0; j < get_ascii_img_w(); j++) {
-                for (scale_x = 0; scale_x < _scale; scale_x++) {
-                    unsigned int color = get_ascii_img_pixel(j, i) ?
-                                            _fg_color : _bg_color;
-                    put_pixel (x + x_off, y + y_off, color);
-                    x_off++;
+    r.x = (p_a->x < p_b->x) ? p_a->x : p_b->x;  r.w = x1 - r.x;
+    r.y = (p_a->y < p_b->y) ? p_a->y : p_b->y;  r.h = y1 - r.y;
+    return  r;
+}
+
+//-----------------------------------------------------------------------------
+// Overlapped or touching regions are merged (repeated, the union may touch
+// the others). list full : merged to the region of the smallest union.
+//
+void lib_fb::_add_dirty (int x, int y, int w, int h)
+{
+    struct disp_region r = { x, y, w, h }, u;
+
+    for (int i = 0; i < _dirty_cnt; ) {
+        struct disp_region *p = &_dirty[i];
+
+        /* already dirty */
+        if ((r.x >= p->x) && (r.y >= p->y) &&
+            (r.x + r.w <= p->x + p->w) && (r.y + r.h <= p->y + p->h))
+            return;
+        if ((r.x <= p->x + p->w) && (p->x <= r.x + r.w) &&
+            (r.y <= p->y + p->h) && (p->y <= r.y + r.h)) {
+            r = _region_union (p, &r);
+            _dirty[i] = _dirty[--_dirty_cnt];
+            i = 0;
+            continue;
+        }
+        i++;
+
+        if ((i == _dirty_cnt) && (_dirty_cnt == FB_DIRTY_RECTS)) {
+            int best = 0, best_area = 0;
+
+            for (int j = 0; j < _dirty_cnt; j++) {
+                int area;
+
+                u = _region_union (&_dirty[j], &r);
+                area = u.w * u.h - _dirty[j].w * _dirty[j].h;
+                if (!j || (area < best_area)) {
+                    best = j;   best_area = area;
                 }
             }
-            y_off++;
+            r = _region_union (&_dirty[best], &r);
+            _dirty[best] = _dirty[--_dirty_cnt];
+            i = 0;
         }
     }
-    return x_off;
+    _dirty[_dirty_cnt++] = r;
 }
 
 //-----------------------------------------------------------------------------
-int lib_fb::_draw_text  (int x, int y, unsigned char *p_str)
+bool lib_fb::get_dirty_bounds (struct disp_region *p_region) const
 {
-    unsigned char c1, c2, c3;
-    int draw_bits_total = 0, draw_bits = 0;
+    int x0, y0, x1, y1;
+
+    if (!_dirty_cnt)
+        return  false;
+
+    x0 = _dirty[0].x;   x1 = _dirty[0].x + _dirty[0].w;
+    y0 = _dirty[0].y;   y1 = _dirty[0].y + _dirty[0].h;
+    for (int i = 1; i < _dirty_cnt; i++) {
+        if (_dirty[i].x < x0)   x0 = _dirty[i].x;
+        if (_dirty[i].y < y0)   y0 = _dirty[i].y;
+        if (_dirty[i].x + _dirty[i].w > x1)     x1 = _dirty[i].x + _dirty[i].w;
+        if (_dirty[i].y + _dirty[i].h > y1)     y1 = _dirty[i].y + _dirty[i].h;
+    }
+    p_region->x = x0;   p_region->w = x1 - x0;
+    p_region->y = y0;   p_region->h = y1 - y0;
+    return  true;
+}
+
+//-----------------------------------------------------------------------------
+// fb regions -> display regions (- offset), blit each, present the bounds.
+//
+bool lib_fb::present_dirty (lib_display &disp, int x_off, int y_off)
+{
+    struct disp_region bounds;
+
+    if (!get_dirty_bounds (&bounds))
+        return  false;
 
-    while(*p_str && _scale) {
+    for (int i = 0; i < _dirty_cnt; i++) {
+        struct disp_region r = _dirty[i];
 
-        c1 = *(unsigned char *)p_str++;
-        //---------- 한글 ---------
-        /* 모든 문자는 기본적으로 UTF-8형태로 저장되며 한글은 3바이트를 가진다. */
-        /* 한글은 3바이트를 읽어 UTF8 to UTF16으로 변환후 초/중/종성을 분리하여 조합형으로 표시한다. */
-        if (c1 >= 0x80) {
-            c2 = *(unsigned char *)p_str++;
-            c3 = *(unsigned char *)p_str++;
+        r.x -= x_off;   r.y -= y_off;
+        disp.blit_region (*this, x_off, y_off, &r);
+    }
+    bounds.x -= x_off;  bounds.y -= y_off;
+    disp.present (&bounds);
+    clear_dirty ();
+    return  true;
+}
+
+//-----------------------------------------------------------------------------
+// Bresenham. each run of the major axis is one span. (fill_rect)
+//
+void lib_fb::draw_line (int x0, int y0, int x1, int y1, unsigned int color)
+{
+    int dx = abs (x1 - x0), dy = abs (y1 - y0);
+    int sx = (x0 < x1) ? 1 : -1, sy = (y0 < y1) ? 1 : -1, err, run;
 
-            make_hangul_img (c1, c2, c3);
-            draw_bits = _draw_hangul_bitmap (x, y);
+    if (dy == 0) {
+        draw_hline ((x0 < x1) ? x0 : x1, y0, dx + 1, color);
+        return;
+    }
+    if (dx == 0) {
+        draw_vline (x0, (y0 < y1) ? y0 : y1, dy + 1, color);
+        return;
+    }
+
+    if (dx >= dy) {
+        /* x major : horizontal runs */
+        err = dx / 2;
+        for (run = x0; ; x0 += sx) {
+            bool end = (x0 == x1);
+
+            err -= dy;
+            if ((err < 0) || end) {
+                draw_hline ((sx > 0) ? run : x0, y0, abs (x0 - run) + 1, color);
+                if (end)
+                    break;
+                y0 += sy;   err += dx;  run = x0 + sx;
+            }
         }
-        //---------- ASCII 8x16 or ASCII 8x8(if scale is 0) ---------
-        else {
-            make_ascii_img (c1);
-            draw_bits = _draw_ascii_bitmap(x, y);
+    } else {
+        /* y major : vertical runs */
+        err = dy / 2;
+        for (run = y0; ; y0 += sy) {
+            bool end = (y0 == y1);
+
+            err -= dx;
+            if ((err < 0) || end) {
+                draw_vline (x0, (sy > 0) ? run : y0, abs (y0 - run) + 1, color);
+                if (end)
+                    break;
+                x0 += sx;   err += dy;  run = y0 + sy;
+            }
         }
-        x += draw_bits;
-        draw_bits_total += draw_bits;
     }
-    printf("\r\ndraw image x bits size = %d\r\n", draw_bits_total);
-    return (draw_bits_total);
+}
+
+//-----------------------------------------------------------------------------
+void lib_fb::draw_rect (int x, int y, int w, int h, unsigned int color)
+{
+    if ((w <= 0) || (h <= 0))
+        return;
+
+    draw_hline (x, y, w, color);
+    if (h > 1)
+        draw_hline (x, y + h - 1, w, color);
+    if (h > 2) {
+        draw_vline (x, y + 1, h - 2, color);
+        if (w > 1)
+            draw_vline (x + w - 1, y + 1, h - 2, color);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// 1bpp : 24 dots of the bitmap line at once (_put_row1), otherwise per pixel.
+//
+void lib_fb::draw_bitmap (int x, int y, const unsigned char *p_bitmap, int w, int h)
+{
+    int stride = (w + 7) / 8, cx = x, cy = y, cw = w, ch = h;
+
+    if (!clip (&cx, &cy, &cw, &ch))
+        return;
+    _add_dirty (cx, cy, cw, ch);
+
+    for (int py = cy; py < cy + ch; py++) {
+        const unsigned char *p_line = &p_bitmap[(py - y) * stride];
+
+        if (_bpp == 1) {
+            for (int k = 0; k < w; k += 24) {
+                unsigned int bits = 0;
+
+                for (int j = 0; (j < 3) && (k + j * 8 < w); j++)
+                    bits |= _bit_reverse (pgm_read_byte (&p_line[k / 8 + j])) << (j * 8);
+                _put_row1 (x + k, py, bits, (w - k > 24) ? 24 : (w - k));
+            }
+            continue;
+        }
+        for (int px = cx; px < cx + cw; px++) {
+            int j = px - x;
+
+            if (pgm_read_byte (&p_line[j / 8]) & (0x80 >> (j % 8)))
+                _plot (px, py, _fg_color);
+            else if (!_transparent)
+                _plot (px, py, _bg_color);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void lib_fb::shift (int dx, int dy)
+{
+    copy_rect (dx, dy, *this, 0, 0, _w, _h);
+
+    if (dx > 0)         fill_rect (0, 0, dx, _h, 0);
+    else if (dx < 0)    fill_rect (_w + dx, 0, -dx, _h, 0);
+    if (dy > 0)         fill_rect (0, 0, _w, dy, 0);
+    else if (dy < 0)    fill_rect (0, _h + dy, _w, -dy, 0);
+}
+
+//-----------------------------------------------------------------------------
+// 1bpp : the pattern byte of the line repeats every 8 dots, so a line is
+// (dst & ~mask) | (src & mask) with the pattern word. edges are masked bytes.
+//
+void lib_fb::copy_pattern (const lib_fb &src, const unsigned char *p_pattern)
+{
+    int x = 0, y = 0, w = (src._w < _w) ? src._w : _w, h = (src._h < _h) ? src._h : _h;
+    int b0, b1;
+    unsigned char m0, m1;
+    bool words;
+
+    if ((src._bpp != _bpp) || !clip (&x, &y, &w, &h))
+        return;
+    _add_dirty (x, y, w, h);
+
+    if (_bpp != 1) {
+        for (int py = y; py < y + h; py++) {
+            for (int px = x; px < x + w; px++) {
+                if ((p_pattern[py & 7] >> (px & 7)) & 1)
+                    _plot (px, py, src.get_pixel (px, py));
+            }
+        }
+        return;
+    }
+
+    b0 = x >> 3;    m0 = 0xFF << (x & 7);
+    b1 = (x + w - 1) >> 3;  m1 = 0xFF >> (7 - ((x + w - 1) & 7));
+    if (b0 == b1)
+        m0 = m1 = m0 & m1;
+    /* 32 bits access : both lines start at a word boundary */
+    words = !(((unsigned long)_p_mem | (unsigned long)src._p_mem | _stride | src._stride) & 3);
+
+    for (int py = y; py < y + h; py++) {
+        unsigned char *p_dst = &_p_mem[py * _stride];
+        const unsigned char *p_src = &src._p_mem[py * src._stride];
+        unsigned char pat = p_pattern[py & 7];
+        unsigned int pat32 = pat * 0x01010101u;
+        int b = b0 + 1;
+
+        p_dst[b0] = (p_dst[b0] & ~(pat & m0)) | (p_src[b0] & pat & m0);
+        if (b0 == b1)
+            continue;
+        while (b < b1) {
+            if (words && !(b & 3) && (b + 4 <= b1)) {
+                unsigned int *p_d = (unsigned int *)&p_dst[b];
+
+                *p_d = (*p_d & ~pat32) | (*(const unsigned int *)&p_src[b] & pat32);
+                b += 4;
+                continue;
+            }
+            p_dst[b] = (p_dst[b] & ~pat) | (p_src[b] & pat);
+            b++;
+        }
+        p_dst[b1] = (p_dst[b1] & ~(pat & m1)) | (p_src[b1] & pat & m1);
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -183,23 +926,359 @@ int lib_fb::my_strlen (char *str)
     return cnt;
 }
 
+//-----------------------------------------------------------------------------
+// Text stream : formatted chars are drawn one by one. (no text buffer)
+// hangul bytes are collected until the 3 byte UTF-8 char is complete.
+//-----------------------------------------------------------------------------
+void lib_fb::_stream_char (unsigned char c)
+{
+    const char *p_char = (const char *)_utf;
+
+    /* broken UTF-8 char is dropped */
+    if (c < 0x80)
+        _utf_n = 0;
+    _utf[_utf_n++] = c;
+    if ((c >= 0x80) && (_utf_n < 3))
+        return;
+    _utf[_utf_n] = 0;   _utf_n = 0;
+    _tx += draw_char (_tx, _ty, &p_char);
+}
+
+//-----------------------------------------------------------------------------
+// p_str (len bytes) in the field width (space padded)
+//
+void lib_fb::_stream_field (const char *p_str, int len, int width, bool left)
+{
+    int fill = (width > len) ? width - len : 0;
+
+    while (!left && fill) {
+        _stream_char (' ');     fill--;
+    }
+    while (len--)
+        _stream_char (*p_str++);
+    while (fill--)
+        _stream_char (' ');
+}
+
+//-----------------------------------------------------------------------------
+// [sign, 0x] [precision zeros] digits in the field width.
+// pad '0' : zeros after the sign / 0x
+//
+void lib_fb::_stream_number (const char *p_head, int head, int zeros,
+                            const char *p_digit, int len, const struct fb_spec &spec)
+{
+    int fill = spec.width - head - zeros - len;
+
+    if (fill < 0)
+        fill = 0;
+    while (!spec.left && (spec.pad == ' ') && fill) {
+        _stream_char (' ');     fill--;
+    }
+    while (head--)
+        _stream_char (*p_head++);
+    while (!spec.left && fill) {
+        _stream_char ('0');     fill--;
+    }
+    while (zeros--)
+        _stream_char ('0');
+    while (len--)
+        _stream_char (*p_digit++);
+    while (fill--)
+        _stream_char (' ');
+}
+
+//-----------------------------------------------------------------------------
+// prec : minimum digits (0 with value 0 : no digit, '0' pad is ignored)
+// alt  : 0x / 0X prefix (hex, value != 0), first digit 0 (octal)
+//
+void lib_fb::_stream_int (unsigned long long value, bool neg, int base, bool upper,
+                            const struct fb_spec &spec)
+{
+    const char *digit = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    /* 64 bits (22 octal digits) */
+    char buf[24], *p = &buf[sizeof(buf)], head[3];
+    int n = 0, len, zeros;
+    struct fb_spec s = spec;
+    unsigned long v;
+
+    if (s.prec >= 0)
+        s.pad = ' ';
+    if (neg)
+        head[n++] = '-';
+    else if (s.sign)
+        head[n++] = s.sign;
+    if (s.alt && (base == 16) && value) {
+        head[n++] = '0';    head[n++] = upper ? 'X' : 'x';
+    }
+
+    /* 64 bit division only while the value needs it */
+    while (value >> 32) {
+        *--p = digit[value % base];
+        value /= base;
+    }
+    v = (unsigned long)value;
+    while (v || ((p == &buf[sizeof(buf)]) && s.prec)) {
+        *--p = digit[v % base];
+        v /= base;
+    }
+    len = &buf[sizeof(buf)] - p;
+    if (s.alt && (base == 8) && (!len || (*p != '0')) && (s.prec <= len))
+        s.prec = len + 1;
+    zeros = (s.prec > len) ? s.prec - len : 0;
+    _stream_number (head, n, zeros, p, len, s);
+}
+
+//-----------------------------------------------------------------------------
+// ipart.fpart (fpart : decimals digits, alt : '.' with no decimals)
+//
+void lib_fb::_stream_fixed (unsigned long long ipart, unsigned long fpart, int decimals,
+                            bool neg, const struct fb_spec &spec)
+{
+    char buf[40], *p = &buf[sizeof(buf)], sign = neg ? '-' : spec.sign;
+    unsigned long v;
+
+    for (int i = 0; i < decimals; i++) {
+        *--p = '0' + fpart % 10;
+        fpart /= 10;
+    }
+    if (decimals || spec.alt)
+        *--p = '.';
+    while (ipart >> 32) {
+        *--p = '0' + ipart % 10;
+        ipart /= 10;
+    }
+    v = (unsigned long)ipart;
+    do {
+        *--p = '0' + v % 10;
+        v /= 10;
+    } while (v);
+    _stream_number (&sign, sign ? 1 : 0, 0, p, &buf[sizeof(buf)] - p, spec);
+}
+
+//-----------------------------------------------------------------------------
+// %f : decimals up to 9. nan, inf and |value| >= 2^64 : "nan" / "inf"
+//
+void lib_fb::_stream_float (double value, bool upper, const struct fb_spec &spec)
+{
+    struct fb_spec s = spec;
+    unsigned long scale = 1, fpart;
+    unsigned long long ipart;
+    bool neg = signbit (value);
+    double mag = neg ? -value : value;
+    int decimals = (s.prec < 0) ? 6 : (s.prec > 9) ? 9 : s.prec;
+
+    /* (unsigned long long) cast of nan / out of range value is undefined */
+    if (isnan (mag) || !(mag < 18446744073709551616.0)) {
+        s.pad = ' ';
+        _stream_number (neg ? "-" : &s.sign, (neg || s.sign) ? 1 : 0, 0,
+                        isnan (mag) ? (upper ? "NAN" : "nan") : (upper ? "INF" : "inf"), 3, s);
+        return;
+    }
+    for (int i = 0; i < decimals; i++)
+        scale *= 10;
+
+    /* rounded at the last decimal (binary halves like 23.45 may round up) */
+    ipart = (unsigned long long)mag;
+    fpart = (unsigned long)((mag - ipart) * scale + 0.5);
+    if (fpart >= scale) {
+        ipart++;    fpart -= scale;
+    }
+    _stream_fixed (ipart, fpart, decimals, neg, s);
+}
+
+//-----------------------------------------------------------------------------
+void lib_fb::_print_arg (long long v)
+{
+    struct fb_spec spec = { 0, -1, false, false, ' ', 0 };
+
+    _stream_int ((v < 0) ? 0ULL - (unsigned long long)v : v, v < 0, 10, false, spec);
+}
+
+//-----------------------------------------------------------------------------
+void lib_fb::_print_arg (unsigned long long v)
+{
+    struct fb_spec spec = { 0, -1, false, false, ' ', 0 };
+
+    _stream_int (v, false, 10, false, spec);
+}
+
+//-----------------------------------------------------------------------------
+void lib_fb::_print_arg (const struct fb_dec &v)
+{
+    struct fb_spec spec = { 0, -1, false, false, ' ', 0 };
+    unsigned long scale = 1, value = (v.value < 0) ? 0UL - (unsigned long)v.value : v.value;
+
+    for (int i = 0; i < v.decimals; i++)
+        scale *= 10;
+    _stream_fixed (value / scale, value % scale, v.decimals, v.value < 0, spec);
+}
+
+//-----------------------------------------------------------------------------
+// printf subset, the fields are drawn while fmt is parsed.
+// every conversion takes its argument, unsupported one (%e %g %a %ls ..) is
+// drawn as it is. %n writes nothing.
+//
+int lib_fb::vdraw_text (int x, int y, const char *fmt, va_list va)
+{
+    _stream_begin (x, y);
+
+    while (_scale && *fmt) {
+        struct fb_spec spec = { 0, -1, false, false, ' ', 0 };
+        const char *p_spec = fmt;
+        char len = 0, c = *fmt++;
+
+        if (c != '%') {
+            _stream_char (c);
+            continue;
+        }
+        /* flags */
+        for (;; fmt++) {
+            if      (*fmt == '-')   spec.left = true;
+            else if (*fmt == '0')   spec.pad  = '0';
+            else if (*fmt == '#')   spec.alt  = true;
+            else if (*fmt == '+')   spec.sign = '+';
+            else if (*fmt == ' ')   spec.sign = spec.sign ? spec.sign : ' ';
+            else
+                break;
+        }
+        /* width, precision (negative * precision : none) */
+        if (*fmt == '*') {
+            spec.width = va_arg (va, int);  fmt++;
+            if (spec.width < 0) {
+                spec.left = true;   spec.width = -spec.width;
+            }
+        }
+        while ((*fmt >= '0') && (*fmt <= '9'))
+            spec.width = spec.width * 10 + (*fmt++ - '0');
+        if (*fmt == '.') {
+            spec.prec = 0;  fmt++;
+            if (*fmt == '*') {
+                spec.prec = va_arg (va, int);   fmt++;
+                if (spec.prec < 0)
+                    spec.prec = -1;
+            }
+            while ((*fmt >= '0') && (*fmt <= '9'))
+                spec.prec = spec.prec * 10 + (*fmt++ - '0');
+        }
+        /* length : H(hh), h, l, q(ll), z, j, t, L */
+        while ((*fmt == 'h') || (*fmt == 'l') || (*fmt == 'z') ||
+               (*fmt == 'j') || (*fmt == 't') || (*fmt == 'L')) {
+            c = *fmt++;
+            len = ((c == 'h') && (len == 'h')) ? 'H' :
+                  ((c == 'l') && (len == 'l')) ? 'q' : c;
+        }
+        if (spec.left)
+            spec.pad = ' ';
+
+        switch (c = *fmt++) {
+            case 'd':   case 'i': {
+                long long v;
+
+                switch (len) {
+                    case 'H':   v = (signed char)va_arg (va, int);  break;
+                    case 'h':   v = (short)va_arg (va, int);        break;
+                    case 'l':   v = va_arg (va, long);              break;
+                    case 'q':   v = va_arg (va, long long);         break;
+                    /* signed size_t : same size as ptrdiff_t */
+                    case 'z':   case 't':
+                                v = va_arg (va, ptrdiff_t);         break;
+                    case 'j':   v = va_arg (va, intmax_t);          break;
+                    default:    v = va_arg (va, int);               break;
+                }
+                _stream_int ((v < 0) ? 0ULL - (unsigned long long)v : v, v < 0,
+                                10, false, spec);
+                }
+                break;
+            case 'u':   case 'o':   case 'x':   case 'X': {
+                unsigned long long v;
+
+                switch (len) {
+                    case 'H':   v = (unsigned char)va_arg (va, unsigned int);   break;
+                    case 'h':   v = (unsigned short)va_arg (va, unsigned int);  break;
+                    case 'l':   v = va_arg (va, unsigned long);         break;
+                    case 'q':   v = va_arg (va, unsigned long long);    break;
+                    case 'z':   v = va_arg (va, size_t);                break;
+                    case 't':   v = (size_t)va_arg (va, ptrdiff_t);     break;
+                    case 'j':   v = va_arg (va, uintmax_t);             break;
+                    default:    v = va_arg (va, unsigned int);          break;
+                }
+                spec.sign = 0;
+                _stream_int (v, false, (c == 'u') ? 10 : (c == 'o') ? 8 : 16,
+                                c == 'X', spec);
+                }
+                break;
+            case 'p': {
+                const void *ptr = va_arg (va, const void *);
+
+                if (ptr) {
+                    spec.alt = true;
+                    _stream_int ((uintptr_t)ptr, false, 16, false, spec);
+                } else
+                    _stream_field ("(nil)", 5, spec.width, spec.left);
+                }
+                break;
+            case 'c':
+                if (len == 'l') {
+                    /* wide char : not drawn */
+                    (void)va_arg (va, wint_t);
+                    goto unsupported;
+                } else {
+                    char ch = (char)va_arg (va, int);
+                    _stream_field (&ch, 1, spec.width, spec.left);
+                }
+                break;
+            case 's': {
+                const char *p_str = va_arg (va, const char *);
+                int n;
+
+                /* wide string : not drawn */
+                if (len == 'l')
+                    goto unsupported;
+                if (!p_str)
+                    p_str = "(null)";
+                n = strlen (p_str);
+                if ((spec.prec >= 0) && (spec.prec < n))
+                    n = spec.prec;
+                _stream_field (p_str, n, spec.width, spec.left);
+                }
+                break;
+            case 'f':   case 'F':
+                _stream_float ((len == 'L') ? (double)va_arg (va, long double) :
+                                va_arg (va, double), c == 'F', spec);
+                break;
+            case 'e':   case 'E':   case 'g':   case 'G':   case 'a':   case 'A':
+                if (len == 'L')     (void)va_arg (va, long double);
+                else                (void)va_arg (va, double);
+                goto unsupported;
+            case 'n':
+                (void)va_arg (va, void *);
+                break;
+            case '%':
+                _stream_char ('%');
+                break;
+            case 0:
+                fmt--;
+                break;
+            default:
+            unsupported:
+                while (p_spec < fmt)
+                    _stream_char (*p_spec++);
+                break;
+        }
+    }
+    return _stream_end ();
+}
+
 //------------------------------------------------------------------------------
-int lib_fb::draw_text  (int x, int y, int scale, char *fmt, ...)
+int lib_fb::draw_textf (int x, int y, const char *fmt, ...)
 {
-    unsigned char buf[512];
     int draw_w_bits;
-
     va_list va;
 
-    memset((void *)buf, 0x00, sizeof(buf));
-
     va_start(va, fmt);
-    vsprintf((char *)buf, fmt, va);
+    draw_w_bits = vdraw_text (x, y, fmt, va);
     va_end(va);
 
-    set_scale (scale);
-    draw_w_bits = _draw_text(x, y, buf);
-
     return draw_w_bits;
 }
 
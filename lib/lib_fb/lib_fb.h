@@ -14,8 +14,11 @@
 #ifndef __LIB_FB_H__
 #define __LIB_FB_H__
 
+#if defined(ARDUINO)
 #include <Arduino.h>
+#endif
 #include "lib_font.h"
+#include "lib_display.h"
 
 //-----------------------------------------------------------------------------
 // Color table & convert macro
@@ -50,6 +53,26 @@
 #define COLOR_TEAL          RGB_TO_UINT(0,128,128)
 #define COLOR_NAVY          RGB_TO_UINT(0,0,128)
 
+//-----------------------------------------------------------------------------
+// Raster operation (d = destination, s = source)
+//-----------------------------------------------------------------------------
+#define FB_ROP_COPY         0   // d = s
+#define FB_ROP_OR           1   // d = d | s
+#define FB_ROP_AND          2   // d = d & s
+#define FB_ROP_XOR          3   // d = d ^ s
+#define FB_ROP_CLEAR        4   // d = d & ~s (mask out)
+
+// clip rect stack depth (push_clip)
+#define FB_CLIP_STACK       4
+// dirty region list size (merged rects)
+#define FB_DIRTY_RECTS      4
+/* proportional text : blank columns after the glyph ink */
+#define FB_GLYPH_SPACING    1
+
+struct fb_clip {
+    int x0, y0, x1, y1;     // x0 ~ (x1 - 1), y0 ~ (y1 - 1)
+};
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 union u_color565 {
@@ -77,6 +100,24 @@ union u_color888 {
     };
 };
 
+//-----------------------------------------------------------------------------
+// fixed point value for lib_fb::print. fb_dec (-235, 1) = "-23.5"
+//-----------------------------------------------------------------------------
+struct fb_dec {
+    long    value;
+    int     decimals;
+    fb_dec (long v, int d) : value (v), decimals (d) {}
+};
+
+//-----------------------------------------------------------------------------
+// vdraw_text conversion spec. sign : 0 / '+' / ' ', alt : '#', prec -1 : none
+//-----------------------------------------------------------------------------
+struct fb_spec {
+    int     width, prec;
+    bool    left, alt;
+    char    pad, sign;
+};
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 class lib_fb : public lib_font
@@ -85,11 +126,84 @@ private:
     int             _w, _h, _bpp, _stride, _size, _bgr,  _scale;
     unsigned char   *_p_mem;
     unsigned int    _bg_color, _fg_color;
+    /* out of range pixel access counter (reads too) */
+    mutable unsigned long   _clip_cnt;
+    /* text background : false = bg_color, true = not drawn */
+    bool            _transparent;
+    /* glyph advance : false = cell width, true = ink columns + spacing */
+    bool            _proportional;
+    /* drawing area (current clip) and the pushed clips */
+    struct fb_clip  _clip, _clip_stack[FB_CLIP_STACK];
+    int             _clip_sp;
+    /* changed area since clear_dirty (merged, disjoint) */
+    struct disp_region  _dirty[FB_DIRTY_RECTS];
+    int             _dirty_cnt;
 
-    int _draw_ascii_bitmap (int x, int y);
-    int _draw_hangul_bitmap (int x, int y);
+    void _add_dirty (int x, int y, int w, int h);
+
+    void _put_row1 (int x, int y, unsigned int bits, int nbits);
+    /* image columns left ~ (left + cols) are drawn */
+    int _draw_bitmap1 (int x, int y, const unsigned char *p_img, int w, int h,
+                        int left, int cols);
+    int _draw_bitmap (int x, int y, const unsigned char *p_img, int w, int h,
+                        int left, int cols);
+    int _draw_ascii_bitmap (int x, int y, int left, int cols);
+    int _draw_hangul_bitmap (int x, int y, int left, int cols);
+    int _draw_columns (unsigned char *p_columns, int max_columns,
+                        const unsigned char *p_img, int w, int h, int left, int cols);
+    int _glyph_cols (const unsigned char *p_str, int bytes, int *p_left);
+    void _rop_row1 (unsigned char *p_dst, int dx, const unsigned char *p_src, int sx,
+                    int w, int rop, bool backward);
+    /* clipped pixel, out of clip is not counted */
+    void _plot (int x, int y, unsigned int color) {
+        if ((x < _clip.x0) || (x >= _clip.x1) || (y < _clip.y0) || (y >= _clip.y1))
+            return;
+        switch (_bpp) {
+            case 32:    put_pixel32 (x, y, color);  break;
+            case 24:    put_pixel24 (x, y, color);  break;
+            case 16:    put_pixel16 (x, y, color);  break;
+            default:    put_pixel1  (x, y, color);  break;
+        }
+    }
     int _draw_text (int x, int y, unsigned char *buf);
 
+    /* text stream : chars go to the glyph pipeline as they are formatted */
+    int             _tx, _tx0, _ty, _utf_n;
+    unsigned char   _utf[4];
+
+    void _stream_begin (int x, int y) { _tx = _tx0 = x; _ty = y; _utf_n = 0; }
+    int  _stream_end () { return _tx - _tx0; }
+    void _stream_char  (unsigned char c);
+    void _stream_field (const char *p_str, int len, int width, bool left);
+    void _stream_number (const char *p_head, int head, int zeros,
+                        const char *p_digit, int len, const struct fb_spec &spec);
+    void _stream_int   (unsigned long long value, bool neg, int base, bool upper,
+                        const struct fb_spec &spec);
+    void _stream_fixed (unsigned long long ipart, unsigned long fpart, int decimals,
+                        bool neg, const struct fb_spec &spec);
+    void _stream_float (double value, bool upper, const struct fb_spec &spec);
+
+    void _print () {}
+    template <typename T, typename... Args>
+    void _print (const T &arg, const Args&... args) {
+        _print_arg (arg);
+        _print (args...);
+    }
+    void _print_arg (const char *str) {
+        while (*str)
+            _stream_char (*str++);
+    }
+    void _print_arg (char c)            { _stream_char (c); }
+    void _print_arg (int v)             { _print_arg ((long)v); }
+    void _print_arg (unsigned int v)    { _print_arg ((unsigned long)v); }
+    void _print_arg (long v)            { _print_arg ((long long)v); }
+    void _print_arg (unsigned long v)   { _print_arg ((unsigned long long)v); }
+    void _print_arg (long long v);
+    void _print_arg (unsigned long long v);
+    void _print_arg (const struct fb_dec &v);
+    /* float / double : use fb_dec (fixed point) */
+    void _print_arg (double v) = delete;
+
 public:
     lib_fb (/* args */);
     /* width (x bits), height (y bits), bits per pixel(1, 16, 32) */
@@ -104,23 +218,211 @@ public:
     void set_color (unsigned int fg_color) { _fg_color = fg_color; }
     unsigned int get_fg_color () { return _fg_color; }
     unsigned int get_bg_color () { return _bg_color; }
-    int get_width () { return _w; }
-    int get_height() { return _h; }
+    /* text background mode (true : only the glyph pixels are drawn) */
+    void set_transparent (bool transparent) { _transparent = transparent; }
+    bool get_transparent () { return _transparent; }
+    /* proportional text (fonts/FontMetrics.h). blank glyph : half cell */
+    void set_proportional (bool proportional) { _proportional = proportional; }
+    bool get_proportional () { return _proportional; }
+    int get_width () const { return _w; }
+    int get_height() const { return _h; }
+    int get_bpp   () const { return _bpp; }
+    int get_stride() const { return _stride; }
+    /* raw framebuffer memory (1bpp : LSB first, x = 0 is bit 0) */
+    const unsigned char *get_mem () const { return _p_mem; }
 
     void clear () {
         memset (_p_mem, COLOR_BLACK, _size);
+        _add_dirty (0, 0, _w, _h);
     }
 
+    /* dirty regions : every drawing (not the unchecked put_pixelN) adds its */
+    /* area. touching areas are merged, up to FB_DIRTY_RECTS regions. */
+    void mark_dirty (int x, int y, int w, int h) {
+        if (clip (&x, &y, &w, &h))
+            _add_dirty (x, y, w, h);
+    }
+    int get_dirty_count () const { return _dirty_cnt; }
+    const struct disp_region *get_dirty () const { return _dirty; }
+    /* bounding box of the dirty regions. false : nothing changed */
+    bool get_dirty_bounds (struct disp_region *p_region) const;
+    void clear_dirty () { _dirty_cnt = 0; }
+
+    /* out of clip (x, y) is counted (get_clip_count) and ignored */
     void put_pixel (int x, int y, unsigned int color);
     void put_pixel (int x, int y) { put_pixel (x, y, _fg_color); };
 
-    unsigned int get_pixel (int x, int y);
+    /* out of range (x, y) is counted and read as 0 */
+    unsigned int get_pixel (int x, int y) const;
+
+    unsigned long get_clip_count () const { return _clip_cnt; }
+    void clear_clip_count () { _clip_cnt = 0; }
+
+    /* clip (x, y, w, h) to the current clip. return false if nothing is visible */
+    bool clip (int *x, int *y, int *w, int *h) const {
+        int x1 = *x + *w, y1 = *y + *h;
+
+        if (*x < _clip.x0)  *x = _clip.x0;
+        if (*y < _clip.y0)  *y = _clip.y0;
+        if (x1 > _clip.x1)  x1 = _clip.x1;
+        if (y1 > _clip.y1)  y1 = _clip.y1;
+        *w = x1 - *x;   *h = y1 - *y;
+        return  (*w > 0) && (*h > 0);
+    }
+
+    /* clip rect stack. push : intersect with the current clip (false : stack full) */
+    /* every drawing (pixel, text, rect, line, bitmap, copy_rect) is clipped */
+    bool push_clip (int x, int y, int w, int h);
+    void pop_clip ();
+    /* whole framebuffer, stack is emptied */
+    void reset_clip ();
+
+    /* unchecked pixel access per bpp. (x, y) must be in the framebuffer */
+    void put_pixel1  (int x, int y, unsigned int color) {
+        unsigned char *p = &_p_mem[y * _stride + (x >> 3)], mask = 0x01 << (x & 7);
+        if (color)  *p |=  mask;
+        else        *p &= ~mask;
+    }
+    void put_pixel16 (int x, int y, unsigned int color) {
+        unsigned char *p = &_p_mem[y * _stride + x * 2];
+        p[0] = color;   p[1] = color >> 8;
+    }
+    void put_pixel24 (int x, int y, unsigned int color) {
+        unsigned char *p = &_p_mem[y * _stride + x * 3];
+        p[0] = color;   p[1] = color >> 8;  p[2] = color >> 16;
+    }
+    void put_pixel32 (int x, int y, unsigned int color) {
+        unsigned char *p = &_p_mem[y * _stride + x * 4];
+        p[0] = color;   p[1] = color >> 8;  p[2] = color >> 16; p[3] = color >> 24;
+    }
+    unsigned int get_pixel1  (int x, int y) const {
+        return  (_p_mem[y * _stride + (x >> 3)] >> (x & 7)) & 0x01;
+    }
+    unsigned int get_pixel16 (int x, int y) const {
+        const unsigned char *p = &_p_mem[y * _stride + x * 2];
+        return  p[0] | (p[1] << 8);
+    }
+    unsigned int get_pixel24 (int x, int y) const {
+        const unsigned char *p = &_p_mem[y * _stride + x * 3];
+        return  p[0] | (p[1] << 8) | (p[2] << 16);
+    }
+    unsigned int get_pixel32 (int x, int y) const {
+        const unsigned char *p = &_p_mem[y * _stride + x * 4];
+        return  p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+    }
+
+    /* 1bpp : 8 pixels from (x, y), LSB = x. out of range pixel = 0 */
+    unsigned char get_byte (int x, int y) const {
+        const unsigned char *p_line = _p_mem + y * _stride;
+        int idx = x >> 3, shift = x & 7;
+        unsigned int data, mask = 0xFF;
+
+        if ((x >= 0) && ((x + 8) <= _w)) {
+            data = p_line[idx];
+            if (shift)
+                data = (data | (p_line[idx + 1] << 8)) >> shift;
+            return  (unsigned char)data;
+        }
+        if ((x <= -8) || (x >= _w))
+            return  0;
+
+        data  = ((idx >= 0) && (idx < _stride))           ? p_line[idx]          : 0;
+        data |= ((idx + 1 >= 0) && (idx + 1 < _stride))   ? p_line[idx + 1] << 8 : 0;
+        data >>= shift;
+
+        if (x < 0)          mask &= (0xFF << (-x));
+        if ((x + 8) > _w)   mask &= (0xFF >> (x + 8 - _w));
+
+        return  (unsigned char)(data & mask);
+    }
+    /* 1bpp : get_byte, x wraps around the framebuffer width (ring buffer) */
+    unsigned char get_byte_wrap (int x, int y) const {
+        x %= _w;
+        if (x < 0)
+            x += _w;
+        return  get_byte (x, y) | get_byte (x - _w, y);
+    }
+
+    /* lines : horizontal / vertical runs are filled as spans (Bresenham) */
+    void draw_line  (int x0, int y0, int x1, int y1, unsigned int color);
+    void draw_hline (int x, int y, int w, unsigned int color) { fill_rect (x, y, w, 1, color); }
+    void draw_vline (int x, int y, int h, unsigned int color) { fill_rect (x, y, 1, h, color); }
+    void draw_rect  (int x, int y, int w, int h, unsigned int color);
+    void fill_rect  (int x, int y, int w, int h, unsigned int color);
+    /* 1bpp bitmap (PROGMEM, MSB first, (w + 7) / 8 bytes per line) */
+    /* bit 1 = fg_color, 0 = bg_color (transparent : not drawn) */
+    void draw_bitmap (int x, int y, const unsigned char *p_bitmap, int w, int h);
+    void invert_rect (int x, int y, int w, int h);
+    void invert () { invert_rect (0, 0, _w, _h); }
+
+    /* src (sx, sy, w, h) -> (dx, dy) with FB_ROP_xxx. clipped to both fb. */
+    /* same bpp. 1bpp : 32 dots at a time, src may be this fb (overlap safe) */
+    void copy_rect (int dx, int dy, const lib_fb &src, int sx, int sy, int w, int h,
+                    int rop = FB_ROP_COPY);
+    /* move the fb contents by (dx, dy), vacated area = 0 */
+    void shift (int dx, int dy);
+    /* src dots where the 8 x 8 pattern bit is set are copied to the same (x, y) */
+    /* p_pattern[y % 8], bit (x % 8). same bpp, 1bpp : 32 dots at a time */
+    void copy_pattern (const lib_fb &src, const unsigned char *p_pattern);
+
+    /* column stream : column-major, get_column_bytes() per column, LSB = top line */
+    /* window of the stream = p_columns + x * get_column_bytes() */
+    int get_column_bytes () const { return (_h + 7) / 8; }
+    /* fb (x ~ x + w) -> w columns. out of range pixel = 0 */
+    void get_columns (unsigned char *p_columns, int x, int w) const;
+
+    /* 8 x 8 bit matrix transpose. bit k of byte r <-> bit r of byte k */
+    static unsigned long long transpose8 (unsigned long long v) {
+        unsigned long long t;
+
+        t = (v ^ (v >>  7)) & 0x00AA00AA00AA00AAull;   v ^= t ^ (t <<  7);
+        t = (v ^ (v >> 14)) & 0x0000CCCC0000CCCCull;   v ^= t ^ (t << 14);
+        t = (v ^ (v >> 28)) & 0x00000000F0F0F0F0ull;   v ^= t ^ (t << 28);
+        return  v;
+    }
+
+    /* copy (x_off, y_off) ~ display size to the display and send the region */
+    void present (lib_display &disp, int x_off, int y_off,
+                    const struct disp_region *p_region = NULL, bool x_wrap = false) {
+        disp.blit (*this, x_off, y_off, x_wrap);
+        disp.present (p_region);
+    }
+
+    /* blit + present the dirty regions only and clear_dirty. */
+    /* (x_off, y_off) must be the same as the last present. false : nothing changed */
+    bool present_dirty (lib_display &disp, int x_off, int y_off);
 
     void set_scale (int scale) { _scale = scale; };
     int  get_scale () { return _scale; };
 
     int my_strlen  (char *str);
-    int draw_text  (int x, int y, int scale, char *fmt, ...);
+    /* UTF-8 char (hangul 3 bytes), *pp_str moves to the next char */
+    int draw_char  (int x, int y, const char **pp_str);
+    int char_width (const char **pp_str);
+    int text_width (const char *str);
+    /* render str to the column stream (fg dots = 1, fb height lines, up to 64) */
+    /* p_columns : text_width (str) * get_column_bytes() bytes. return columns */
+    int draw_text_columns (unsigned char *p_columns, int max_columns, const char *str);
+    /* printf subset (%d %i %u %o %x %X %p %c %s %f %F %%, flags - 0 + space #, */
+    /* width, .prec, hh h l ll z j t L). %e %g %a : drawn as it is (arg skipped) */
+    /* formatted straight to the glyphs, no text buffer. return : draw width */
+    int draw_textf (int x, int y, const char *fmt, ...);
+    int vdraw_text (int x, int y, const char *fmt, va_list va);
+    /* fmt with args, (x, y, scale, str) draws str as it is */
+    template <typename T, typename... Args>
+    int draw_text  (int x, int y, int scale, const char *fmt, T arg, Args... args) {
+        set_scale (scale);
+        return draw_textf (x, y, fmt, arg, args...);
+    };
+    /* type-safe text : strings, chars, integers and fb_dec are drawn in order */
+    /* without format parsing. fb.print (0, 0, "temp ", fb_dec (235, 1), "C") */
+    template <typename... Args>
+    int print (int x, int y, const Args&... args) {
+        _stream_begin (x, y);
+        if (_scale)
+            _print (args...);
+        return _stream_end ();
+    }
     int draw_text  (int x, int y, const char *str) {
         return _draw_text  (x, y, (unsigned char *)str);
     };
@@ -181,13 +181,13 @@ void lib_font::_make_image (unsigned char f_m_l, int img_base)
 }
 
 //-----------------------------------------------------------------------------
-void lib_font::make_hangul_img (unsigned char c1, unsigned char c2, unsigned char c3)
+void lib_font::_hangul_index (unsigned char c1, unsigned char c2, unsigned char c3,
+                                int *p_index)
 {
     unsigned char f, m, l;
     unsigned char f1, f2, f3;
     unsigned short utf16 = 0;
 
-    memset (_hangul_img, 0x00, sizeof(_hangul_img));
     /*------------------------------
     UTF-8 을 UTF-16으로 변환한다.
 
@@ -209,9 +209,23 @@ void lib_font::make_hangul_img (unsigned char c1, unsigned char c2, unsigned cha
     f2 = _D_FM[(f * 2) + (l != 0)];
     f1 = _D_MF[(m * 2) + (l != 0)];
 
-    if (f)  {   _make_image(0, (f1*16 + f1 *4 + f)); }
-    if (m)  {   _make_image(1, (        f2*22 + m)); }
-    if (l)  {   _make_image(2, (f3*32 - f3 *4 + l)); }
+    p_index[0] = f ? (f1*16 + f1 *4 + f) : 0;
+    p_index[1] = m ? (        f2*22 + m) : 0;
+    p_index[2] = l ? (f3*32 - f3 *4 + l) : 0;
+}
+
+//-----------------------------------------------------------------------------
+void lib_font::make_hangul_img (unsigned char c1, unsigned char c2, unsigned char c3)
+{
+    int index[3];
+
+    memset (_hangul_img, 0x00, sizeof(_hangul_img));
+    _hangul_index (c1, c2, c3, index);
+
+    for (int i = 0; i < 3; i++) {
+        if (index[i])
+            _make_image (i, index[i]);
+    }
 
     #if defined(TEST_MAKE_IMG)
     {
@@ -242,5 +256,60 @@ bool lib_font::get_hangul_img_pixel (int w, int h)
         __func__, w, get_hangul_img_w(), h, get_hangul_img_w());
     return false;
 }
+
+//-----------------------------------------------------------------------------
+// Glyph extents (fonts/FontMetrics.h, tools/gen_font_metrics.py)
+//-----------------------------------------------------------------------------
+void lib_font::get_ascii_extent (const char ascii, int *p_left, int *p_width)
+{
+    unsigned char _ascii = ascii;
+    const unsigned char *p_ext;
+
+    switch (_ascii_font) {
+        case    eASCII_FONT_8x8:
+            /* 128 glyphs */
+            p_ext = (_ascii < 128) ? FONT_ASCII_8x8_EXT[_ascii] : FONT_ASCII_8x8_EXT[0];
+        break;
+        case    eASCII_FONT_16x32:
+            p_ext = FONT_ASCII_16x32_EXT[_ascii];
+        break;
+        default :
+        case    eASCII_FONT_8x16:
+            p_ext = FONT_ASCII_8x16_EXT[_ascii];
+        break;
+    }
+    *p_left  = pgm_read_byte (p_ext);
+    *p_width = pgm_read_byte (p_ext + 1);
+}
+
+//-----------------------------------------------------------------------------
+void lib_font::get_hangul_extent (unsigned char c1, unsigned char c2, unsigned char c3,
+                                    int *p_left, int *p_width)
+{
+    /* 초성/중성/종성 extent table of each font (eHANGUL_FONTS order) */
+    static const unsigned char (*const ext[eHANGUL_FONT_END][3])[2] = {
+        { FONT_HANGUL1_EXT,   FONT_HANGUL2_EXT,   FONT_HANGUL3_EXT   },
+        { FONT_HANBOOT1_EXT,  FONT_HANBOOT2_EXT,  FONT_HANBOOT3_EXT  },
+        { FONT_HANGODIC1_EXT, FONT_HANGODIC2_EXT, FONT_HANGODIC3_EXT },
+        { FONT_HANPIL1_EXT,   FONT_HANPIL2_EXT,   FONT_HANPIL3_EXT   },
+        { FONT_HANSOFT1_EXT,  FONT_HANSOFT2_EXT,  FONT_HANSOFT3_EXT  },
+    };
+    int index[3], left = get_hangul_img_w (), right = 0;
+    int font = (_hangul_font < eHANGUL_FONT_END) ? _hangul_font : eHANGUL_FONT_HANSOFT;
+
+    _hangul_index (c1, c2, c3, index);
+    for (int i = 0; i < 3; i++) {
+        const unsigned char *p_ext = ext[font][i][index[i]];
+        int l = pgm_read_byte (p_ext), w = pgm_read_byte (p_ext + 1);
+
+        if (!index[i] || !w)
+            continue;
+        if (l < left)       left  = l;
+        if (l + w > right)  right = l + w;
+    }
+    *p_left  = (right > left) ? left : 0;
+    *p_width = (right > left) ? right - left : 0;
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
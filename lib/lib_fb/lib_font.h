@@ -14,7 +14,18 @@
 #ifndef __LIB_FONT_H__
 #define __LIB_FONT_H__
 
+#if defined(ARDUINO)
 #include <Arduino.h>
+#else
+/* host build */
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#define PROGMEM
+#define pgm_read_byte(addr)     (*(const unsigned char *)(addr))
+#define pgm_read_word(addr)     (*(const unsigned short *)(addr))
+#define pgm_read_dword(addr)    (*(const unsigned int *)(addr))
+#endif
 
 #include "fonts/FontHanboot.h"
 #include "fonts/FontHangodic.h"
@@ -26,6 +37,7 @@
 #include "fonts/FontAscii_16x32.h"
 #include "fonts/FontAscii_8x16.h"
 #include "fonts/FontAscii_8x8.h"
+#include "fonts/FontMetrics.h"
 
 //-----------------------------------------------------------------------------
 enum eASCII_FONTS {
@@ -64,6 +76,8 @@ private:
 
     /* make hangul image */
     void _make_image (unsigned char f_m_l, int img_base);
+    /* UTF-8 hangul -> 초성/중성/종성 image index (0 : none) */
+    void _hangul_index (unsigned char c1, unsigned char c2, unsigned char c3, int *p_index);
 
 public:
     lib_font (/* args */):_ascii_font(eASCII_FONT_8x16), _hangul_font(eHANGUL_FONT_HANSOFT) {};
@@ -86,6 +100,9 @@ public:
     int get_hangul_img_h()  { return 16; };
     unsigned char *get_hangul_img_p()   { return &_hangul_img[0]; };
     bool get_hangul_img_pixel (int w, int h);
+    /* ink columns of the syllable (union of the parts). width 0 : blank */
+    void get_hangul_extent (unsigned char c1, unsigned char c2, unsigned char c3,
+                            int *p_left, int *p_width);
 
     void set_ascii_font (enum eASCII_FONTS  font)   { _ascii_font  = font; };
     void make_ascii_img  (const char ascii);
@@ -93,6 +110,8 @@ public:
     int get_ascii_img_h();
     unsigned char *get_ascii_img_p()    { return &_ascii_img[0]; };
     bool get_ascii_img_pixel  (int w, int h);
+    /* ink columns of the glyph (fonts/FontMetrics.h). width 0 : blank */
+    void get_ascii_extent (const char ascii, int *p_left, int *p_width);
 };
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,217 @@
+//-----------------------------------------------------------------------------
+/**
+ * @file lib_layers.cpp
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Layer compositor. (lib_fb layers with mask, offset and z-order)
+ * @version 0.1
+ * @date 2023-06-28
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lib_layers.h"
+
+//-----------------------------------------------------------------------------
+lib_layers::lib_layers (lib_fb &out)
+{
+    _p_out = &out;
+    _num_of_layer = 0;
+
+    /* background of the whole output at the first compose */
+    out.mark_dirty (0, 0, out.get_width (), out.get_height ());
+}
+
+//-----------------------------------------------------------------------------
+int lib_layers::add (lib_fb *p_fb, const lib_fb *p_mask, int z)
+{
+    struct fb_layer *p_layer;
+
+    if ((_num_of_layer >= FB_LAYERS_MAX) || !p_fb)
+        return  -1;
+
+    p_layer = &_layer[_num_of_layer];
+    memset (p_layer, 0, sizeof(struct fb_layer));
+    p_layer->p_fb    = p_fb;
+    p_layer->p_mask  = p_mask;
+    p_layer->w       = p_fb->get_width ();
+    p_layer->h       = p_fb->get_height ();
+    p_layer->z       = z;
+    p_layer->visible = true;
+    p_layer->changed = true;
+    return  _num_of_layer++;
+}
+
+//-----------------------------------------------------------------------------
+void lib_layers::set_pos (int id, int x, int y)
+{
+    if ((id < 0) || (id >= _num_of_layer))
+        return;
+    if ((_layer[id].x != x) || (_layer[id].y != y)) {
+        _layer[id].x = x;   _layer[id].y = y;
+        _layer[id].changed = true;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void lib_layers::set_src (int id, int sx, int sy, int w, int h, bool x_wrap)
+{
+    struct fb_layer *p_layer;
+
+    if ((id < 0) || (id >= _num_of_layer))
+        return;
+    p_layer = &_layer[id];
+    if ((p_layer->sx != sx) || (p_layer->sy != sy) || (p_layer->w != w) ||
+        (p_layer->h != h) || (p_layer->x_wrap != x_wrap)) {
+        p_layer->sx = sx;   p_layer->sy = sy;
+        p_layer->w  = w;    p_layer->h  = h;
+        p_layer->x_wrap  = x_wrap;
+        p_layer->changed = true;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void lib_layers::set_mask (int id, const lib_fb *p_mask)
+{
+    if ((id < 0) || (id >= _num_of_layer))
+        return;
+    _layer[id].p_mask  = p_mask;
+    _layer[id].changed = true;
+}
+
+//-----------------------------------------------------------------------------
+void lib_layers::set_visible (int id, bool visible)
+{
+    if ((id < 0) || (id >= _num_of_layer) || (_layer[id].visible == visible))
+        return;
+    _layer[id].visible = visible;
+    _layer[id].changed = true;
+}
+
+//-----------------------------------------------------------------------------
+void lib_layers::set_z (int id, int z)
+{
+    if ((id < 0) || (id >= _num_of_layer) || (_layer[id].z == z))
+        return;
+    _layer[id].z = z;
+    _layer[id].changed = true;
+}
+
+//-----------------------------------------------------------------------------
+void lib_layers::set_changed (int id)
+{
+    if ((id < 0) || (id >= _num_of_layer))
+        return;
+    _layer[id].changed = true;
+}
+
+//-----------------------------------------------------------------------------
+// changed layer : old + new output rect, otherwise the dirty regions of the
+// layer fb inside the shown part. (ring layer : whole rect)
+//
+void lib_layers::_damage_layer (struct fb_layer *p_layer)
+{
+    lib_fb *p_fb = p_layer->p_fb;
+
+    if (p_layer->changed) {
+        if (p_layer->shown.w)
+            _p_out->mark_dirty (p_layer->shown.x, p_layer->shown.y,
+                                p_layer->shown.w, p_layer->shown.h);
+        if (p_layer->visible)
+            _p_out->mark_dirty (p_layer->x, p_layer->y, p_layer->w, p_layer->h);
+    } else if (p_layer->visible && p_fb->get_dirty_count ()) {
+        if (p_layer->x_wrap)
+            _p_out->mark_dirty (p_layer->x, p_layer->y, p_layer->w, p_layer->h);
+
+        for (int i = 0; !p_layer->x_wrap && (i < p_fb->get_dirty_count ()); i++) {
+            const struct disp_region *p_r = &p_fb->get_dirty ()[i];
+            int x0 = (p_r->x > p_layer->sx) ? p_r->x : p_layer->sx;
+            int y0 = (p_r->y > p_layer->sy) ? p_r->y : p_layer->sy;
+            int x1 = (p_r->x + p_r->w < p_layer->sx + p_layer->w) ?
+                        p_r->x + p_r->w : p_layer->sx + p_layer->w;
+            int y1 = (p_r->y + p_r->h < p_layer->sy + p_layer->h) ?
+                        p_r->y + p_r->h : p_layer->sy + p_layer->h;
+
+            if ((x1 > x0) && (y1 > y0))
+                _p_out->mark_dirty (p_layer->x + x0 - p_layer->sx,
+                                    p_layer->y + y0 - p_layer->sy, x1 - x0, y1 - y0);
+        }
+    }
+    p_fb->clear_dirty ();
+
+    p_layer->changed = false;
+    p_layer->shown.x = p_layer->x;  p_layer->shown.w = p_layer->visible ? p_layer->w : 0;
+    p_layer->shown.y = p_layer->y;  p_layer->shown.h = p_layer->h;
+}
+
+//-----------------------------------------------------------------------------
+void lib_layers::_draw_segment (const struct fb_layer *p_layer, int x, int sx, int w)
+{
+    if (p_layer->p_mask)
+        _p_out->copy_rect (x, p_layer->y, *p_layer->p_mask, sx, p_layer->sy,
+                            w, p_layer->h, FB_ROP_CLEAR);
+    _p_out->copy_rect (x, p_layer->y, *p_layer->p_fb, sx, p_layer->sy,
+                        w, p_layer->h, FB_ROP_OR);
+}
+
+//-----------------------------------------------------------------------------
+// ring layer : split at the end of the layer fb
+//
+void lib_layers::_draw_layer (const struct fb_layer *p_layer)
+{
+    int fb_w = p_layer->p_fb->get_width (), sx, w;
+
+    if (!p_layer->x_wrap) {
+        _draw_segment (p_layer, p_layer->x, p_layer->sx, p_layer->w);
+        return;
+    }
+    sx = ((p_layer->sx % fb_w) + fb_w) % fb_w;
+    w  = (p_layer->w < fb_w - sx) ? p_layer->w : fb_w - sx;
+    _draw_segment (p_layer, p_layer->x, sx, w);
+    if (p_layer->w > w)
+        _draw_segment (p_layer, p_layer->x + w, 0, p_layer->w - w);
+}
+
+//-----------------------------------------------------------------------------
+// damaged area of the output : clip, clear, all visible layers in z order.
+//
+bool lib_layers::compose ()
+{
+    struct disp_region damage[FB_DIRTY_RECTS];
+    int order[FB_LAYERS_MAX], n;
+
+    for (int i = 0; i < _num_of_layer; i++)
+        _damage_layer (&_layer[i]);
+
+    if (!(n = _p_out->get_dirty_count ()))
+        return  false;
+    memcpy (damage, _p_out->get_dirty (), n * sizeof(struct disp_region));
+
+    /* z order (insertion sort, same z : add order) */
+    for (int i = 0; i < _num_of_layer; i++) {
+        int j = i;
+
+        while ((j > 0) && (_layer[order[j - 1]].z > _layer[i].z)) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    for (int k = 0; k < n; k++) {
+        _p_out->push_clip (damage[k].x, damage[k].y, damage[k].w, damage[k].h);
+        _p_out->fill_rect (damage[k].x, damage[k].y, damage[k].w, damage[k].h, 0);
+        for (int i = 0; i < _num_of_layer; i++) {
+            if (_layer[order[i]].visible)
+                _draw_layer (&_layer[order[i]]);
+        }
+        _p_out->pop_clip ();
+    }
+    return  true;
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
@@ -0,0 +1,96 @@
+//-----------------------------------------------------------------------------
+/**
+ * @file lib_layers.h
+ * @author charles-park (charles-park@hardkernel.com)
+ * @brief Layer compositor. (lib_fb layers with mask, offset and z-order)
+ * @version 0.1
+ * @date 2023-06-28
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Each layer is a lib_fb (same bpp as the output) shown at its output
+ * position. A layer is composited with word-wide raster ops :
+ *  out = (out & ~mask) | content     (mask = NULL : out |= content)
+ * content dots must be inside the mask.
+ *
+ * Only the changed area is composited again : the old / new rect of the
+ * moved layers and the dirty regions of the layer framebuffers. The area
+ * is added to the output dirty list, so present_dirty sends only that.
+ *
+ *  lib_fb      out (128, 16), clock (40, 16), clock_mask (40, 16);
+ *  lib_layers  layers (out);
+ *  int text  = layers.add (&marquee.get_fb (), NULL, 0);
+ *  int label = layers.add (&clock, &clock_mask, 1);
+ *  layers.set_src (text, marquee.render (pos), 0, 128, 16, true);
+ *  layers.compose ();
+ *  out.present_dirty (matrix, 0, 0);
+ */
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+#ifndef __LIB_LAYERS_H__
+#define __LIB_LAYERS_H__
+
+#include "lib_fb.h"
+
+//-----------------------------------------------------------------------------
+#define FB_LAYERS_MAX       8
+
+struct fb_layer {
+    lib_fb          *p_fb;
+    // opacity mask (1 = layer dot, 0 = lower layers), NULL = content only
+    const lib_fb    *p_mask;
+    // output position, shown part of the layer fb
+    int             x, y, sx, sy, w, h;
+    // sx wraps around the layer fb width (ring framebuffer, lib_marquee)
+    bool            x_wrap;
+    int             z;
+    bool            visible;
+
+    // position / source / order changed since the last compose
+    bool            changed;
+    // output rect of the last compose (w = 0 : not shown)
+    struct disp_region  shown;
+};
+
+//-----------------------------------------------------------------------------
+class lib_layers
+{
+private:
+    lib_fb          *_p_out;
+    struct fb_layer _layer[FB_LAYERS_MAX];
+    int             _num_of_layer;
+
+    void _damage_layer  (struct fb_layer *p_layer);
+    void _draw_layer    (const struct fb_layer *p_layer);
+    void _draw_segment  (const struct fb_layer *p_layer, int x, int sx, int w);
+
+public:
+    // output fb is owned by the compositor (background = 0)
+    lib_layers (lib_fb &out);
+    ~lib_layers () {};
+
+    // return layer id (-1 : FB_LAYERS_MAX). whole fb at (0, 0), visible
+    int  add (lib_fb *p_fb, const lib_fb *p_mask = NULL, int z = 0);
+    void set_pos     (int id, int x, int y);
+    // shown part (sx, sy, w, h) of the layer fb
+    void set_src     (int id, int sx, int sy, int w, int h, bool x_wrap = false);
+    void set_mask    (int id, const lib_fb *p_mask);
+    void set_visible (int id, bool visible);
+    // higher z is drawn on top (same z : add order)
+    void set_z       (int id, int z);
+    // content changed without the fb dirty list (unchecked put_pixelN)
+    void set_changed (int id);
+
+    const struct fb_layer *get_layer (int id) const {
+        return  ((id >= 0) && (id < _num_of_layer)) ? &_layer[id] : NULL;
+    }
+
+    // composite the changed area to the output. false : nothing changed
+    bool compose ();
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+#endif  // #define __LIB_LAYERS_H__
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
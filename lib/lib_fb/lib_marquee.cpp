@@ -0,0 +1,216 @@
+//-----------------------------------------------------------------------------
+/**
+ * @file lib_marquee.cpp
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Scrolling text with a ring framebuffer. (lazy glyph render)
+ * @version 0.1
+ * @date 2023-06-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lib_marquee.h"
+
+//-----------------------------------------------------------------------------
+// ring width : view + one glyph, multiple of 8 (1bpp stride)
+//
+lib_marquee::lib_marquee (int view_w, int h, int bpp, int max_glyph_w)
+    : _fb (((view_w + max_glyph_w + 7) / 8) * 8, h, bpp)
+{
+    _view_w = view_w;   _max_glyph_w = max_glyph_w;
+    _p_text = NULL;     _text_len = 0;  _text_w = 0;
+
+    _fb.clear ();
+    _restart (0);
+}
+
+//-----------------------------------------------------------------------------
+lib_marquee::~lib_marquee ()
+{
+    if (_p_text)
+        delete[]    _p_text;
+}
+
+//-----------------------------------------------------------------------------
+bool lib_marquee::_set_text (bool append, const char *fmt, va_list args)
+{
+    int len, keep = append ? _text_len : 0;
+    char *p_text;
+    va_list args_copy;
+
+    va_copy (args_copy, args);
+    len = vsnprintf (NULL, 0, fmt, args_copy);
+    va_end (args_copy);
+    if (len < 0)
+        return  false;
+
+    p_text = new char [keep + len + 1];
+    if (!p_text)
+        return  false;
+    if (keep)
+        memcpy (p_text, _p_text, keep);
+    vsnprintf (p_text + keep, len + 1, fmt, args);
+
+    if (_p_text)
+        delete[]    _p_text;
+    _p_text = p_text;   _text_len = keep + len;
+
+    if (!append) {
+        _text_w = _fb.text_width (_p_text);
+        _restart (0);
+        return  true;
+    }
+
+    /* blank columns after the old text end are rendered again with the new text */
+    if (_render_x > _text_w) {
+        int ring_w = _fb.get_width ();
+
+        if (_valid_x < _render_x - ring_w)
+            _valid_x = _render_x - ring_w;
+        _render_x = _text_w;
+    }
+    _text_w += _fb.text_width (p_text + keep);
+    return  true;
+}
+
+//-----------------------------------------------------------------------------
+bool lib_marquee::set_text (const char *fmt, ...)
+{
+    va_list args;
+    bool ret;
+
+    va_start (args, fmt);
+    ret = _set_text (false, fmt, args);
+    va_end (args);
+    return  ret;
+}
+
+//-----------------------------------------------------------------------------
+bool lib_marquee::add_text (const char *fmt, ...)
+{
+    va_list args;
+    bool ret;
+
+    va_start (args, fmt);
+    ret = _set_text (true, fmt, args);
+    va_end (args);
+    return  ret;
+}
+
+//-----------------------------------------------------------------------------
+// ring data is dropped. render again from text x = pos (pos < 0 : blank lead)
+//
+void lib_marquee::_restart (int pos)
+{
+    _next = 0;
+    _render_x = _valid_x = (pos < 0) ? pos : 0;
+}
+
+//-----------------------------------------------------------------------------
+// skip (not render) the chars before pos
+//
+void lib_marquee::_skip_to (int pos)
+{
+    while (_render_x < pos) {
+        const char *p_char = _p_text ? _p_text + _next : "";
+        int w = _fb.char_width (&p_char);
+
+        /* end of text : blank */
+        if (!w) {
+            _render_x = pos;
+            break;
+        }
+        if (_render_x + w > pos)
+            break;
+        _render_x += w;
+        _next = p_char - _p_text;
+    }
+    _valid_x = _render_x;
+}
+
+//-----------------------------------------------------------------------------
+// fill text x ~ (x + w) with bg color. (ring end is wrapped)
+//
+void lib_marquee::_fill (int x, int w)
+{
+    int ring_w = _fb.get_width (), rx = ((x % ring_w) + ring_w) % ring_w;
+
+    _fb.fill_rect (rx, 0, w, _fb.get_height (), _fb.get_bg_color ());
+    if (rx + w > ring_w)
+        _fb.fill_rect (rx - ring_w, 0, w, _fb.get_height (), _fb.get_bg_color ());
+}
+
+//-----------------------------------------------------------------------------
+// render the glyphs until text x = pos + view width
+//
+void lib_marquee::_render (int pos)
+{
+    int ring_w = _fb.get_width (), end_x = pos + _view_w;
+
+    if ((pos < _valid_x) || (pos < _render_x - ring_w))
+        _restart (pos);
+    if (pos > _render_x)
+        _skip_to (pos);
+
+    while (_render_x < end_x) {
+        const char *p_char = _p_text ? _p_text + _next : "";
+        int w = (_render_x < 0) ? 0 : _fb.char_width (&p_char);
+
+        /* lead or end of text : blank */
+        if (!w) {
+            w = (_render_x < 0) ? -_render_x : end_x - _render_x;
+            if (w > _max_glyph_w)
+                w = _max_glyph_w;
+            _fill (_render_x, w);
+        } else {
+            int rx = _render_x % ring_w;
+
+            _fill (_render_x, w);
+            p_char = _p_text + _next;
+            _fb.draw_char (rx, 0, &p_char);
+            /* glyph over the ring end : the rest is drawn at the ring start */
+            if (rx + w > ring_w) {
+                p_char = _p_text + _next;
+                _fb.draw_char (rx - ring_w, 0, &p_char);
+            }
+            _next = p_char - _p_text;
+        }
+        _render_x += w;
+    }
+}
+
+//-----------------------------------------------------------------------------
+int lib_marquee::render (int pos)
+{
+    int ring_w = _fb.get_width ();
+
+    _render (pos);
+    return  ((pos % ring_w) + ring_w) % ring_w;
+}
+
+//-----------------------------------------------------------------------------
+void lib_marquee::show (lib_display &disp, int pos, int y_off)
+{
+    _fb.present (disp, render (pos), y_off, NULL, true);
+}
+
+//-----------------------------------------------------------------------------
+// ring end : the rest of the view is at the ring start
+//
+void lib_marquee::copy_view (lib_fb &dst, int pos, int x, int y)
+{
+    int rx = render (pos), w = _fb.get_width () - rx;
+
+    if (w > _view_w)
+        w = _view_w;
+    dst.copy_rect (x, y, _fb, rx, 0, w, _fb.get_height ());
+    if (w < _view_w)
+        dst.copy_rect (x + w, y, _fb, 0, 0, _view_w - w, _fb.get_height ());
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
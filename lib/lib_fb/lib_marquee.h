@@ -0,0 +1,77 @@
+//-----------------------------------------------------------------------------
+/**
+ * @file lib_marquee.h
+ * @author charles-park (charles-park@hardkernel.com)
+ * @brief Scrolling text with a ring framebuffer. (lazy glyph render)
+ * @version 0.1
+ * @date 2023-06-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Only the visible window + one glyph is kept in a ring framebuffer.
+ * Glyphs are rendered when they enter the window, so the memory is
+ * O(panel width) and the text length is limited only by the string.
+ *
+ *  lib_marquee marquee (128, 16);
+ *  marquee.set_text ("%s %s", date, weather);
+ *  for (int i = 0; i < marquee.get_width (); i++)
+ *      marquee.show (matrix, i);
+ */
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+#ifndef __LIB_MARQUEE_H__
+#define __LIB_MARQUEE_H__
+
+#include <stdarg.h>
+#include "lib_fb.h"
+
+//-----------------------------------------------------------------------------
+class lib_marquee
+{
+private:
+    int         _view_w, _max_glyph_w;
+    // ring framebuffer (text x -> ring x = text x % ring width)
+    lib_fb      _fb;
+
+    char        *_p_text;
+    int         _text_len, _text_w;
+
+    // next char to render (_p_text offset) and its text x
+    int         _next, _render_x;
+    // ring data is valid for text x : max(_valid_x, _render_x - ring width) ~ _render_x
+    int         _valid_x;
+
+    void _restart   (int pos);
+    void _skip_to   (int pos);
+    void _fill      (int x, int w);
+    void _render    (int pos);
+    bool _set_text  (bool append, const char *fmt, va_list args);
+
+public:
+    // max_glyph_w : widest glyph (hangul 16 dots * scale)
+    lib_marquee (int view_w, int h, int bpp = 1, int max_glyph_w = 32);
+    ~lib_marquee ();
+
+    // ring framebuffer (set_color, set_scale, set_transparent before set_text)
+    lib_fb &get_fb () { return _fb; }
+
+    bool set_text (const char *fmt, ...);
+    bool add_text (const char *fmt, ...);
+    const char *get_text () const { return _p_text ? _p_text : ""; }
+    // text width (dots)
+    int get_width () const { return _text_w; }
+
+    // render text x (pos) ~ (pos + view width). return : ring x of pos
+    // (lib_layers : set_src (id, render (pos), 0, view width, h, true))
+    int  render (int pos);
+    // show text x (pos) ~ (pos + view width) at the display. pos < 0 : blank lead
+    void show (lib_display &disp, int pos, int y_off = 0);
+    // copy text x (pos) ~ (pos + view width) to dst (x, y). (lib_transition views)
+    void copy_view (lib_fb &dst, int pos, int x = 0, int y = 0);
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+#endif  // #define __LIB_MARQUEE_H__
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
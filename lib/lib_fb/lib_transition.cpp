@@ -0,0 +1,161 @@
+//-----------------------------------------------------------------------------
+/**
+ * @file lib_transition.cpp
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief View transition effects. (slide, push, wipe, split, dissolve)
+ * @version 0.1
+ * @date 2023-06-30
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lib_transition.h"
+
+//-----------------------------------------------------------------------------
+// 8 x 8 ordered dither (bayer) level of each dot. [y % 8][x % 8]
+//
+static const PROGMEM unsigned char _DITHER_8x8[8][8] = {
+    {  0, 32,  8, 40,  2, 34, 10, 42 },
+    { 48, 16, 56, 24, 50, 18, 58, 26 },
+    { 12, 44,  4, 36, 14, 46,  6, 38 },
+    { 60, 28, 52, 20, 62, 30, 54, 22 },
+    {  3, 35, 11, 43,  1, 33,  9, 41 },
+    { 51, 19, 59, 27, 49, 17, 57, 25 },
+    { 15, 47,  7, 39, 13, 45,  5, 37 },
+    { 63, 31, 55, 23, 61, 29, 53, 21 },
+};
+
+//-----------------------------------------------------------------------------
+lib_transition::lib_transition (int view_w, int h, int bpp)
+    : _from (view_w, h, bpp), _to (view_w, h, bpp), _out (view_w, h, bpp)
+{
+    _from.clear ();     _to.clear ();   _out.clear ();
+    _effect = FB_TR_CUT;
+    _frames = _frame = _pos = 0;
+}
+
+//-----------------------------------------------------------------------------
+void lib_transition::start (int effect, int frames)
+{
+    _effect = ((effect >= 0) && (effect < FB_TR_END)) ? effect : FB_TR_CUT;
+    _frames = (frames > 0) ? frames : 1;
+    _frame  = _pos = 0;
+
+    _out.copy_rect (0, 0, _from, 0, 0, _out.get_width (), _out.get_height ());
+}
+
+//-----------------------------------------------------------------------------
+// progress at the last frame
+//
+int lib_transition::_range ()
+{
+    switch (_effect) {
+        /* new view at the last frame only */
+        case FB_TR_CUT:
+            return  1;
+        case FB_TR_SLIDE_UP:    case FB_TR_SLIDE_DOWN:
+        case FB_TR_PUSH_UP:     case FB_TR_PUSH_DOWN:
+            return  _out.get_height ();
+        case FB_TR_SPLIT:
+            return  (_out.get_width () + 1) / 2;
+        case FB_TR_DISSOLVE:
+            return  64;
+        default:
+            return  _out.get_width ();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// output of progress last -> pos. slide, wipe, split and dissolve change the
+// new area only, push moves both views. (aligned lines : word copies)
+//
+void lib_transition::_render (int last, int pos)
+{
+    int w = _out.get_width (), h = _out.get_height (), c = w / 2;
+
+    switch (_effect) {
+        case FB_TR_SLIDE_UP:
+            _out.copy_rect (0, h - pos, _to, 0, 0, w, pos);
+            break;
+        case FB_TR_SLIDE_DOWN:
+            _out.copy_rect (0, 0, _to, 0, h - pos, w, pos);
+            break;
+        case FB_TR_PUSH_UP:
+            _out.copy_rect (0, 0, _from, 0, pos, w, h - pos);
+            _out.copy_rect (0, h - pos, _to, 0, 0, w, pos);
+            break;
+        case FB_TR_PUSH_DOWN:
+            _out.copy_rect (0, pos, _from, 0, 0, w, h - pos);
+            _out.copy_rect (0, 0, _to, 0, h - pos, w, pos);
+            break;
+        case FB_TR_PUSH_LEFT:
+            _out.copy_rect (0, 0, _from, pos, 0, w - pos, h);
+            _out.copy_rect (w - pos, 0, _to, 0, 0, pos, h);
+            break;
+        case FB_TR_PUSH_RIGHT:
+            _out.copy_rect (pos, 0, _from, 0, 0, w - pos, h);
+            _out.copy_rect (0, 0, _to, w - pos, 0, pos, h);
+            break;
+        case FB_TR_WIPE_LEFT:
+            _out.copy_rect (w - pos, 0, _to, w - pos, 0, pos - last, h);
+            break;
+        case FB_TR_WIPE_RIGHT:
+            _out.copy_rect (last, 0, _to, last, 0, pos - last, h);
+            break;
+        case FB_TR_SPLIT:
+            _out.copy_rect (c - pos, 0, _to, c - pos, 0, pos - last, h);
+            _out.copy_rect (c + last, 0, _to, c + last, 0, pos - last, h);
+            break;
+        case FB_TR_DISSOLVE: {
+            unsigned char pattern[8];
+
+            /* dots of the dither level last ~ (pos - 1) */
+            for (int y = 0; y < 8; y++) {
+                pattern[y] = 0;
+                for (int x = 0; x < 8; x++) {
+                    int level = pgm_read_byte (&_DITHER_8x8[y][x]);
+
+                    if ((level >= last) && (level < pos))
+                        pattern[y] |= 1 << x;
+                }
+            }
+            _out.copy_pattern (_to, pattern);
+            }
+            break;
+        default:
+            _out.copy_rect (0, 0, _to, 0, 0, w, h);
+            break;
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool lib_transition::step ()
+{
+    int pos;
+
+    if (!is_running ())
+        return  false;
+
+    _frame++;
+    pos = (_frame * _range ()) / _frames;
+    if ((pos != _pos) || (_frame == _frames))
+        _render (_pos, pos);
+    _pos = pos;
+    return  true;
+}
+
+//-----------------------------------------------------------------------------
+bool lib_transition::show (lib_display &disp, int y_off)
+{
+    if (!step ())
+        return  false;
+    _out.present_dirty (disp, 0, y_off);
+    return  true;
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
@@ -0,0 +1,88 @@
+//-----------------------------------------------------------------------------
+/**
+ * @file lib_transition.h
+ * @author charles-park (charles-park@hardkernel.com)
+ * @brief View transition effects. (slide, push, wipe, split, dissolve)
+ * @version 0.1
+ * @date 2023-06-30
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * The old and the new view are kept in view sized framebuffers and each
+ * frame is built in the output fb with whole line copies (copy_rect) or
+ * the 8 x 8 dither pattern (copy_pattern). Slide, wipe, split and dissolve
+ * frames change only the new area, present_dirty sends only that.
+ *
+ *  lib_transition  tr (128, 16);
+ *  marquee.copy_view (tr.get_from (), pos);
+ *  marquee.set_text ("new message");
+ *  marquee.copy_view (tr.get_to (), 0);
+ *  tr.start (FB_TR_PUSH_UP, 16);
+ *  while (tr.show (matrix));
+ */
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+#ifndef __LIB_TRANSITION_H__
+#define __LIB_TRANSITION_H__
+
+#include "lib_fb.h"
+
+//-----------------------------------------------------------------------------
+// Effects
+//-----------------------------------------------------------------------------
+// new view at once
+#define FB_TR_CUT           0
+// new view moves in over the old one (from the bottom / top)
+#define FB_TR_SLIDE_UP      1
+#define FB_TR_SLIDE_DOWN    2
+// old view is pushed out by the new one
+#define FB_TR_PUSH_UP       3
+#define FB_TR_PUSH_DOWN     4
+#define FB_TR_PUSH_LEFT     5
+#define FB_TR_PUSH_RIGHT    6
+// new view is uncovered (from the right / left), nothing moves
+#define FB_TR_WIPE_LEFT     7
+#define FB_TR_WIPE_RIGHT    8
+// new view is uncovered from the center to both sides
+#define FB_TR_SPLIT         9
+// new view dots appear in the 8 x 8 ordered dither order
+#define FB_TR_DISSOLVE      10
+#define FB_TR_END           11
+
+//-----------------------------------------------------------------------------
+class lib_transition
+{
+private:
+    // old / new view and the shown frame
+    lib_fb      _from, _to, _out;
+    int         _effect, _frames, _frame;
+    // progress of the shown frame (lines, dots or dither levels)
+    int         _pos;
+
+    int  _range ();
+    void _render (int last, int pos);
+
+public:
+    lib_transition (int view_w, int h, int bpp = 1);
+    ~lib_transition () {};
+
+    // views of the transition. draw or copy (lib_marquee::copy_view) before start
+    lib_fb &get_from () { return _from; }
+    lib_fb &get_to   () { return _to; }
+    // shown frame
+    lib_fb &get_out  () { return _out; }
+
+    // output = old view. the last of the frames is the new view
+    void start (int effect, int frames);
+    bool is_running () const { return _frame < _frames; }
+    // next frame to the output. false : transition is done
+    bool step ();
+    // step and present the changed area. (y_off : lib_marquee::show) false : done
+    bool show (lib_display &disp, int y_off = 0);
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+#endif  // #define __LIB_TRANSITION_H__
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
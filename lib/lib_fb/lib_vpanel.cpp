@@ -0,0 +1,87 @@
+//-----------------------------------------------------------------------------
+/**
+ * @file lib_vpanel.cpp
+ * @author charles-park (charles-park@hardkernel.com)
+ * @brief Virtual panel display. (lib_display, terminal / PBM output)
+ * @version 0.1
+ * @date 2023-06-22
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include "lib_vpanel.h"
+
+//-----------------------------------------------------------------------------
+lib_vpanel::lib_vpanel (int w, int h)
+{
+    _w = w;     _h = h;
+    _stride = (_w + 7) / 8;
+    _p_mem  = new unsigned char [_stride * _h];
+    memset (_p_mem, 0, _stride * _h);
+    _p_pbm  = NULL;
+    _frames = 0;
+}
+
+//-----------------------------------------------------------------------------
+lib_vpanel::~lib_vpanel ()
+{
+    if (_p_mem)
+        delete[]    _p_mem;
+}
+
+//-----------------------------------------------------------------------------
+void lib_vpanel::set_pixel (int x, int y, bool onoff)
+{
+    unsigned char mask = 0x01 << (x % 8);
+
+    if ((x < 0) || (y < 0) || (x >= _w) || (y >= _h))
+        return;
+
+    if (onoff)  _p_mem[y * _stride + (x / 8)] |=  mask;
+    else        _p_mem[y * _stride + (x / 8)] &= ~mask;
+}
+
+//-----------------------------------------------------------------------------
+// PBM (P4) : whole panel, MSB = left pixel. console : region only
+//
+void lib_vpanel::present (const struct disp_region *p_region)
+{
+    struct disp_region r = { 0, 0, _w, _h };
+
+    _frames++;
+#if !defined(ARDUINO)
+    if (_p_pbm) {
+        FILE *fp = fopen (_p_pbm, "wb");
+
+        if (!fp)
+            return;
+        fprintf (fp, "P4\n%d %d\n", _w, _h);
+        for (int i = 0; i < _stride * _h; i++) {
+            unsigned char b = _p_mem[i];
+
+            b = ((b & 0xF0) >> 4) | ((b & 0x0F) << 4);
+            b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
+            b = ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
+            fputc (b, fp);
+        }
+        fclose (fp);
+        return;
+    }
+#endif
+    if (p_region) {
+        r = *p_region;
+        align_region (&r);
+    }
+    printf ("\r\nframe %lu (%d, %d, %d, %d)\r\n", _frames, r.x, r.y, r.w, r.h);
+    for (int y = r.y; y < r.y + r.h; y++) {
+        for (int x = r.x; x < r.x + r.w; x++)
+            putchar (get_pixel (x, y) ? '#' : '.');
+        printf ("\r\n");
+    }
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
@@ -0,0 +1,60 @@
+//-----------------------------------------------------------------------------
+/**
+ * @file lib_vpanel.h
+ * @author charles-park (charles-park@hardkernel.com)
+ * @brief Virtual panel display. (lib_display, terminal / PBM output)
+ * @version 0.1
+ * @date 2023-06-22
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Shows the framebuffer without the panel. present() prints the region
+ * to the console ('#' = on, '.' = off) or writes a PBM image file(host).
+ *
+ *  lib_vpanel  panel (128, 16);
+ *  panel.set_pbm ("frame.pbm");
+ *  fb.present (panel, 0, 0);
+ */
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+#ifndef __LIB_VPANEL_H__
+#define __LIB_VPANEL_H__
+
+#include "lib_display.h"
+
+//-----------------------------------------------------------------------------
+class lib_vpanel : public lib_display
+{
+private:
+    int             _w, _h, _stride;
+    // 1bpp, LSB first (lib_fb 1bpp)
+    unsigned char   *_p_mem;
+    // PBM file path (NULL : console)
+    const char      *_p_pbm;
+    unsigned long   _frames;
+
+public:
+    lib_vpanel (int w, int h);
+    ~lib_vpanel ();
+
+    void set_pbm (const char *path) { _p_pbm = path; }
+    unsigned long get_frames () const { return _frames; }
+    bool get_pixel (int x, int y) const {
+        return  (_p_mem[y * _stride + (x / 8)] >> (x % 8)) & 0x01;
+    }
+
+    // lib_display
+    int get_width  () const { return _w; }
+    int get_height () const { return _h; }
+    int get_format () const { return DISP_FMT_ROW1_LSB; }
+    unsigned char *get_buffer () { return _p_mem; }
+    int get_buffer_stride () const { return _stride; }
+    void set_pixel (int x, int y, bool onoff);
+    void present (const struct disp_region *p_region = NULL);
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+#endif  // #define __LIB_VPANEL_H__
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
@@ -58,6 +58,8 @@ void fb_console_display(int w, int h)
     fb.draw_text(0,  0, 1, "%s", "한글A");
     fb.set_ascii_font (eASCII_FONT_8x8);
     fb.draw_text(0, 16, 1, "%s", "C한글");
+    /* no format string : "T-3.5" */
+    fb.print (24, 16, "T", fb_dec (-35, 1));
 
     for (int i = 0; i < fb.get_height(); i++) {
         printf ("\n\r");
@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------
+# lib_fb proportional glyph tables (fonts/FontMetrics.h)
+#
+# {left, width} of the ink columns of each glyph image. (width 0 : blank)
+# hangul : each part image (초성/중성/종성), the syllable is the union.
+#   python3 tools/gen_font_metrics.py > fonts/FontMetrics.h
+#------------------------------------------------------------------------------
+import re, os
+
+FONTS = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "fonts")
+
+def arrays (header):
+    text = open(os.path.join(FONTS, header)).read()
+    text = re.sub(r"/\*.*?\*/", "", text, flags = re.S)
+    text = re.sub(r"//[^\n]*", "", text)
+    for m in re.finditer(r"(\w+)\s*\[\s*\]\s*\[\s*(\d+)\s*\]\s*=\s*\{(.*?)\};", text, re.S):
+        data = [int(v, 0) for v in re.findall(r"0[xX][0-9a-fA-F]+|\d+", m.group(3))]
+        size = int(m.group(2))
+        yield m.group(1), [data[i:i + size] for i in range(0, len(data), size)]
+
+def extent (img, w):
+    stride, bits = w // 8, 0
+    for i in range(0, len(img), stride):
+        line = 0
+        for b in img[i:i + stride]:
+            line = (line << 8) | b
+        bits |= line
+    if not bits:
+        return (0, 0)
+    # MSB = left dot
+    left  = w - bits.bit_length()
+    right = w - ((bits & -bits).bit_length() - 1)
+    return (left, right - left)
+
+def table (name, glyphs, w):
+    print("const PROGMEM unsigned char %s_EXT[%d][2] = {" % (name, len(glyphs)))
+    ext = [extent(g, w) for g in glyphs]
+    for i in range(0, len(ext), 8):
+        print("\t" + " ".join("{%2d,%2d}," % e for e in ext[i:i + 8]))
+    print("};\n")
+
+print("//-----------------------------------------------------------------------------")
+print("#ifndef __FONT_METRICS_H__")
+print("#define __FONT_METRICS_H__")
+print("/* generated by tools/gen_font_metrics.py : {left, width} ink columns */")
+for header, w in (("FontAscii_8x8.h", 8), ("FontAscii_8x16.h", 8), ("FontAscii_16x32.h", 16),
+                  ("FontHangul.h", 16), ("FontHanboot.h", 16), ("FontHangodic.h", 16),
+                  ("FontHanpil.h", 16), ("FontHansoft.h", 16)):
+    for name, glyphs in arrays(header):
+        table(name, glyphs, w)
+print("#endif  // __FONT_METRICS_H__")
+print("//-----------------------------------------------------------------------------")
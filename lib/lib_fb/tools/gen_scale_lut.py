@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------
+# lib_fb glyph scale tables (fonts/FontScale.h)
+#
+# byte (LSB = left dot) -> each bit repeated 2 / 3 / 4 times.
+#   python3 tools/gen_scale_lut.py > fonts/FontScale.h
+#------------------------------------------------------------------------------
+def spread (b, scale):
+    v = 0
+    for i in range(8):
+        if (b >> i) & 1:
+            v |= ((1 << scale) - 1) << (i * scale)
+    return v
+
+def table (name, ctype, scale, digits):
+    print("const PROGMEM %s %s[256] = {" % (ctype, name))
+    for i in range(0, 256, 8):
+        print("\t" + ", ".join("0x%0*X" % (digits, spread(b, scale)) for b in range(i, i + 8)) + ",")
+    print("};\n")
+
+print("//-----------------------------------------------------------------------------")
+print("#ifndef __FONT_SCALE_H__")
+print("#define __FONT_SCALE_H__")
+print("/* generated by tools/gen_scale_lut.py : byte (LSB = left dot) x 2, 3, 4 */")
+table("FONT_SCALE_X2", "unsigned short", 2, 4)
+table("FONT_SCALE_X3", "unsigned int",   3, 6)
+table("FONT_SCALE_X4", "unsigned int",   4, 8)
+print("#endif  // __FONT_SCALE_H__")
+print("//-----------------------------------------------------------------------------")
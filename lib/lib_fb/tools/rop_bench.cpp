@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+// lib_fb raster op benchmark (host build, no Arduino)
+//
+// copy_rect (32 dots at a time) vs per pixel, fill / invert / shift.
+// 1920 x 16 1bpp (4 line billboard message width)
+//   cd lib/lib_fb
+//   g++ -O2 -I. tools/rop_bench.cpp *.cpp -o /tmp/rop_bench && /tmp/rop_bench
+//------------------------------------------------------------------------------
+/* host only (not built into the firmware with the library sources) */
+#if !defined(ARDUINO)
+#include <lib_fb.h>
+#include <stdio.h>
+#include <time.h>
+
+#define LOOP    200
+
+//------------------------------------------------------------------------------
+static double micros_f ()
+{
+    struct timespec t;
+
+    clock_gettime (CLOCK_MONOTONIC, &t);
+    return  t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+//------------------------------------------------------------------------------
+int main ()
+{
+    lib_fb src(1920, 16, 1), dst(1920, 16, 1);
+    double start, rop_us, pixel_us, bytes = 1900 * 16 / 8;
+
+    src.clear();    dst.clear();
+    src.draw_text(0, 0, 1, "%s", "Raster op benchmark 한글 ABC 0123456789");
+
+    start = micros_f();
+    for (int i = 0; i < LOOP; i++)
+        dst.copy_rect(i % 7, 0, src, 3, 0, 1900, 16, FB_ROP_XOR);
+    rop_us = (micros_f() - start) / LOOP;
+
+    start = micros_f();
+    for (int i = 0; i < LOOP; i++)
+        for (int y = 0; y < 16; y++)
+            for (int x = 0; x < 1900; x++)
+                dst.put_pixel(x + i % 7, y,
+                            dst.get_pixel(x + i % 7, y) ^ src.get_pixel(x + 3, y));
+    pixel_us = (micros_f() - start) / LOOP;
+
+    printf("copy_rect(xor) : %8.2f us, %6.1f bytes/us\n", rop_us, bytes / rop_us);
+    printf("per pixel      : %8.2f us, %6.1f bytes/us (x%.1f)\n",
+            pixel_us, bytes / pixel_us, pixel_us / rop_us);
+
+    start = micros_f();
+    for (int i = 0; i < LOOP; i++) {
+        dst.fill_rect(1, 1, 1900, 14, 1);   dst.invert_rect(5, 0, 1800, 16);
+        dst.shift(-1, 0);
+    }
+    printf("fill + invert + shift : %8.2f us\n", (micros_f() - start) / LOOP);
+    return  0;
+}
+
+//------------------------------------------------------------------------------
+#endif  // !ARDUINO
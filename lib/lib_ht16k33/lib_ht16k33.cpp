@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+/**
+ * @file lib_ht16k33.cpp
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief HT16K33 I2C LED matrix driver. (lib_display)
+ * @version 0.1
+ * @date 2023-06-22
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Data sheet
+ * https://www.holtek.com/documents/10179/116711/HT16K33v120.pdf
+*/
+//------------------------------------------------------------------------------
+#if defined(ARDUINO)
+#include <Wire.h>
+#else
+#include <string.h>
+#endif
+#include "lib_ht16k33.h"
+
+//------------------------------------------------------------------------------
+// command (D7 ~ D4 : register, D3 ~ D0 : data)
+//------------------------------------------------------------------------------
+#define HT16K33_CMD_RAM         0x00
+#define HT16K33_CMD_SYSTEM      0x20    // D0 : oscillator on
+#define HT16K33_CMD_DISPLAY     0x80    // D0 : display on, D2 ~ D1 : blink
+#define HT16K33_CMD_DIMMING     0xE0    // D3 ~ D0 : duty
+
+//------------------------------------------------------------------------------
+lib_ht16k33::lib_ht16k33 (int addr, int w, int h)
+{
+    _addr = addr;
+    _w = (w > 8) ? 16 : 8;
+    _h = ((h > 0) && (h <= HT16K33_RAM_LINES)) ? h : HT16K33_RAM_LINES;
+
+    memset (_ram, 0, sizeof(_ram));
+    _ram_sent_valid = false;
+}
+
+//------------------------------------------------------------------------------
+void lib_ht16k33::_write_cmd (unsigned char cmd)
+{
+#if defined(ARDUINO)
+    Wire.beginTransmission (_addr);
+    Wire.write (cmd);
+    Wire.endTransmission ();
+#endif
+}
+
+//------------------------------------------------------------------------------
+// RAM address auto increment : one transfer for the lines
+//
+void lib_ht16k33::_write_ram (int line, int lines)
+{
+#if defined(ARDUINO)
+    Wire.beginTransmission (_addr);
+    Wire.write (HT16K33_CMD_RAM | (line * HT16K33_RAM_STRIDE));
+    Wire.write (&_ram[line * HT16K33_RAM_STRIDE], lines * HT16K33_RAM_STRIDE);
+    Wire.endTransmission ();
+#endif
+    memcpy (&_ram_sent[line * HT16K33_RAM_STRIDE], &_ram[line * HT16K33_RAM_STRIDE],
+            lines * HT16K33_RAM_STRIDE);
+}
+
+//------------------------------------------------------------------------------
+void lib_ht16k33::begin ()
+{
+    /* oscillator on, display on (blink off), max brightness */
+    _write_cmd (HT16K33_CMD_SYSTEM | 0x01);
+    _write_cmd (HT16K33_CMD_DISPLAY | 0x01);
+    brightness (0x0F);
+
+    memset (_ram, 0, sizeof(_ram));
+    _write_ram (0, HT16K33_RAM_LINES);
+    _ram_sent_valid = true;
+}
+
+//------------------------------------------------------------------------------
+void lib_ht16k33::brightness (unsigned char brightness)
+{
+    _write_cmd (HT16K33_CMD_DIMMING | (brightness & 0x0F));
+}
+
+//------------------------------------------------------------------------------
+void lib_ht16k33::blink (unsigned char rate)
+{
+    _write_cmd (HT16K33_CMD_DISPLAY | ((rate & 0x03) << 1) | 0x01);
+}
+
+//------------------------------------------------------------------------------
+void lib_ht16k33::set_pixel (int x, int y, bool onoff)
+{
+    unsigned char *p_ram, mask = 0x01 << (x % 8);
+
+    if ((x < 0) || (y < 0) || (x >= _w) || (y >= _h))
+        return;
+
+    p_ram = &_ram[y * HT16K33_RAM_STRIDE + (x / 8)];
+    if (onoff)  *p_ram |=  mask;
+    else        *p_ram &= ~mask;
+}
+
+//------------------------------------------------------------------------------
+// lines from the first changed line to the last changed line of the region
+//
+void lib_ht16k33::present (const struct disp_region *p_region)
+{
+    struct disp_region r = { 0, 0, _w, _h };
+    int first = -1, last = -1;
+
+    if (p_region) {
+        r = *p_region;
+        align_region (&r);
+    }
+    for (int y = r.y; y < r.y + r.h; y++) {
+        if (_ram_sent_valid &&
+            !memcmp (&_ram[y * HT16K33_RAM_STRIDE], &_ram_sent[y * HT16K33_RAM_STRIDE],
+                    HT16K33_RAM_STRIDE))
+            continue;
+        if (first < 0)
+            first = y;
+        last = y;
+    }
+    if (first >= 0)
+        _write_ram (first, last - first + 1);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
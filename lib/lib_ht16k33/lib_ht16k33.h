@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------------
+/**
+ * @file lib_ht16k33.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief HT16K33 I2C LED matrix driver. (lib_display)
+ * @version 0.1
+ * @date 2023-06-22
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Data sheet
+ * https://www.holtek.com/documents/10179/116711/HT16K33v120.pdf
+ *
+ * Display RAM : 8 COM(line) x 16 ROW(dot), 2 bytes per line, LSB = ROW0.
+ * The same layout as lib_fb 1bpp, so lib_fb is copied without bit conversion.
+ *
+ *  lib_ht16k33 panel (0x70, 16, 8);
+ *  panel.begin ();
+ *  fb.present (panel, x_offset, 0);
+*/
+//------------------------------------------------------------------------------
+#ifndef __LIB_HT16K33_H__
+#define __LIB_HT16K33_H__
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#endif
+#include <lib_display.h>
+
+//------------------------------------------------------------------------------
+#define HT16K33_ADDR            0x70
+#define HT16K33_RAM_LINES       8
+#define HT16K33_RAM_STRIDE      2
+
+// blink rate (display setup register B2 ~ B1)
+#define HT16K33_BLINK_OFF       0
+#define HT16K33_BLINK_2HZ       1
+#define HT16K33_BLINK_1HZ       2
+#define HT16K33_BLINK_HALFHZ    3
+
+//------------------------------------------------------------------------------
+class lib_ht16k33 : public lib_display
+{
+private:
+    int             _addr, _w, _h;
+    // display RAM image [line][ROW0-7, ROW8-15], sent RAM image
+    unsigned char   _ram[HT16K33_RAM_LINES * HT16K33_RAM_STRIDE];
+    unsigned char   _ram_sent[HT16K33_RAM_LINES * HT16K33_RAM_STRIDE];
+    bool            _ram_sent_valid;
+
+    void _write_cmd (unsigned char cmd);
+    void _write_ram (int line, int lines);
+
+public:
+    // w : 8 or 16 dots, h : 1 ~ 8 lines
+    lib_ht16k33 (int addr = HT16K33_ADDR, int w = 16, int h = 8);
+    ~lib_ht16k33 () {};
+
+    // I2C (Wire) must be started. ex) Wire.begin (SDA, SCL)
+    void begin ();
+    // brightness : 0x0 ~ 0xF (1/16 ~ 16/16 duty)
+    void brightness (unsigned char brightness);
+    void blink (unsigned char rate);
+    void clear () {
+        memset (_ram, 0, sizeof(_ram));
+    }
+
+    // lib_display
+    int get_width  () const { return _w; }
+    int get_height () const { return _h; }
+    int get_format () const { return DISP_FMT_ROW1_LSB; }
+    int get_x_align () const { return 8; }
+    unsigned char *get_buffer () { return _ram; }
+    int get_buffer_stride () const { return HT16K33_RAM_STRIDE; }
+    void set_pixel (int x, int y, bool onoff);
+    // only the changed lines of the region are written. (one I2C transfer)
+    void present (const struct disp_region *p_region = NULL);
+};
+
+//------------------------------------------------------------------------------
+#endif  // __LIB_HT16K33_H__
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------------
+/**
+ * @file test_ht16k33.c
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief HT16K33 16x8 LED matrix test.(esp8266 d1_mini)
+ * @version 0.1
+ * @date 2023-06-22
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Data sheet
+ * https://www.holtek.com/documents/10179/116711/HT16K33v120.pdf
+*/
+//------------------------------------------------------------------------------
+#include <Wire.h>
+#include <lib_fb.h>
+#include <lib_ht16k33.h>
+
+//------------------------------------------------------------------------------
+lib_ht16k33 panel (HT16K33_ADDR, 16, 8);
+lib_fb fb (256, 8, 1);
+
+//------------------------------------------------------------------------------
+void setup()
+{
+    Serial.begin(115200);
+    // Board LED초기화. 동작상황 표시함.
+    pinMode(2,  OUTPUT);
+
+    // I2C (D2 = SDA, D1 = SCL)
+    Wire.begin (4, 5);
+    Wire.setClock (400000);
+
+    panel.begin ();
+    panel.brightness (0x04);
+
+    fb.set_ascii_font (eASCII_FONT_8x8);
+    fb.clear ();
+}
+
+//------------------------------------------------------------------------------
+void loop()
+{
+    int draw_w = fb.draw_text (0, 0, 1, "HT16K33 Test..");
+
+    for (int i = 0; i < draw_w; i++) {
+        digitalWrite(2, i & 1);
+        fb.present (panel, i, 0);
+        delay (50);
+    }
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -15,8 +15,121 @@
  * https://www.analog.com/media/en/technical-documentation/data-sheets/max7219-max7221.pdf
 */
 //------------------------------------------------------------------------------
+#if defined(ARDUINO)
 #include <SPI.h>
+#endif
 #include <lib_matrix.h>
+#include <matrix_layout.h>
+#include <lib_fb.h>
+
+#if !defined(ARDUINO)
+#include <time.h>
+//------------------------------------------------------------------------------
+// host build (matrix_spi transport only)
+//------------------------------------------------------------------------------
+static inline void delay (unsigned long ms) {}
+static inline void yield () {}
+static inline void noInterrupts () {}
+static inline void interrupts () {}
+static inline unsigned long micros () {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return  ts.tv_sec * 1000000UL + ts.tv_nsec / 1000UL;
+}
+static inline unsigned long millis () {
+    return  micros () / 1000UL;
+}
+#endif
+
+// timer1 re-check period while SPI busy. (TIM_DIV16 : 5 ticks = 1us)
+#define TX_POLL_TICKS   10
+
+//------------------------------------------------------------------------------
+// lib_fb(LSB first) <-> matrix(MSB first) bit order
+//------------------------------------------------------------------------------
+static inline unsigned char _bit_reverse (unsigned char b)
+{
+    b = ((b & 0xF0) >> 4) | ((b & 0x0F) << 4);
+    b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
+    b = ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
+    return  b;
+}
+
+//------------------------------------------------------------------------------
+// 8x8 module image as 64 bit word. (line n = bits 8n ~ 8n+7, MSB = left dot)
+//------------------------------------------------------------------------------
+static inline uint64_t IRAM_ATTR _module_load (const unsigned char *p_line)
+{
+    uint64_t data = 0;
+
+    for (int i = 7; i >= 0; i--)
+        data = (data << 8) | p_line[i];
+    return  data;
+}
+
+//------------------------------------------------------------------------------
+static inline void IRAM_ATTR _module_store (unsigned char *p_line, uint64_t data)
+{
+    for (int i = 0; i < 8; i++, data >>= 8)
+        p_line[i] = (unsigned char)data;
+}
+
+//------------------------------------------------------------------------------
+// mirror x : reverse the bits of each line
+static inline uint64_t IRAM_ATTR _module_mirror_x (uint64_t x)
+{
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return  x;
+}
+
+//------------------------------------------------------------------------------
+// mirror y : reverse the line order
+static inline uint64_t IRAM_ATTR _module_mirror_y (uint64_t x)
+{
+    x = ((x >>  8) & 0x00FF00FF00FF00FFULL) | ((x & 0x00FF00FF00FF00FFULL) <<  8);
+    x = ((x >> 16) & 0x0000FFFF0000FFFFULL) | ((x & 0x0000FFFF0000FFFFULL) << 16);
+    x = (x >> 32) | (x << 32);
+    return  x;
+}
+
+//------------------------------------------------------------------------------
+// 8x8 bit transpose of the word (bit 8r+c <-> bit 8c+r, Hacker's Delight 7-3)
+static inline uint64_t IRAM_ATTR _module_transpose (uint64_t x)
+{
+    uint64_t t;
+
+    t = (x ^ (x >>  7)) & 0x00AA00AA00AA00AAULL;    x = x ^ t ^ (t <<  7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;    x = x ^ t ^ (t << 28);
+    return  x;
+}
+
+//------------------------------------------------------------------------------
+// module image transform. (mirror first, then clockwise rotation)
+//
+static uint64_t IRAM_ATTR _module_orient (uint64_t x, unsigned char orient)
+{
+    if (orient & MATRIX_MIRROR_X)   x = _module_mirror_x (x);
+    if (orient & MATRIX_MIRROR_Y)   x = _module_mirror_y (x);
+
+    switch (orient & MATRIX_ROT_MASK) {
+        /* transpose of the word = anti-diagonal flip of the module image */
+        case    MATRIX_ROT_90:
+            x = _module_mirror_y (_module_transpose (x));
+        break;
+        case    MATRIX_ROT_180:
+            x = _module_mirror_y (_module_mirror_x (x));
+        break;
+        case    MATRIX_ROT_270:
+            x = _module_mirror_x (_module_transpose (x));
+        break;
+        default :
+        break;
+    }
+    return  x;
+}
 
 //------------------------------------------------------------------------------
 void lib_matrix::set_bit (int x, int y, bool onoff)
@@ -48,6 +161,312 @@ bool lib_matrix::get_bit (int x, int y)
     return  (module_line_byte & control_bit_mask) ? true : false;
 }
 
+//------------------------------------------------------------------------------
+// Copy 1bpp framebuffer to matrix buffer 8 dots(one module line) at a time.
+// out of range area of framebuffer is filled with 0.
+//
+void lib_matrix::blit (const lib_fb &fb, int x_off, int y_off, bool x_wrap)
+{
+    int num_module_x = _x_dots / 8;
+
+    if (fb.get_bpp() != 1) {
+        for (int y = 0; y < _y_dots; y++) {
+            for (int x = 0; x < _x_dots; x++) {
+                int fx = x_off + x, fy = y_off + y;
+                bool onoff;
+
+                if (x_wrap)
+                    fx = ((fx % fb.get_width()) + fb.get_width()) % fb.get_width();
+                onoff = (fx >= 0) && (fy >= 0) &&
+                            (fx < fb.get_width()) && (fy < fb.get_height()) &&
+                            fb.get_pixel(fx, fy);
+                set_pixel (x, y, onoff);
+            }
+        }
+        return;
+    }
+
+    for (int y = 0; y < _y_dots; y++) {
+        // _p_fb[module number][line of module]
+        unsigned char *p_dst = &_p_fb[(y / 8) * num_module_x * 8 + (y % 8)];
+        int fy = y_off + y;
+
+        if ((fy < 0) || (fy >= fb.get_height())) {
+            for (int j = 0; j < num_module_x; j++, p_dst += 8)
+                *p_dst = 0;
+            continue;
+        }
+
+        for (int j = 0; j < num_module_x; j++, p_dst += 8)
+            *p_dst = _bit_reverse (x_wrap ? fb.get_byte_wrap (x_off + j * 8, fy) :
+                                            fb.get_byte (x_off + j * 8, fy));
+    }
+}
+
+//------------------------------------------------------------------------------
+// lib_fb pixel to luminance (0 ~ 255)
+//
+static unsigned char _fb_luma (const lib_fb &fb, int x, int y)
+{
+    unsigned int color = fb.get_pixel (x, y), r, g, b;
+
+    switch (fb.get_bpp()) {
+        case 16:
+            r = ((color >> 11) & 0x1F) << 3;
+            g = ((color >>  5) & 0x3F) << 2;
+            b = ((color      ) & 0x1F) << 3;
+            break;
+        case 24:    case 32:
+            r = UINT_TO_R(color);   g = UINT_TO_G(color);   b = UINT_TO_B(color);
+            break;
+        default:
+            return  color ? 0xFF : 0x00;
+    }
+    return  (r * 77 + g * 150 + b * 29) >> 8;
+}
+
+//------------------------------------------------------------------------------
+// level : 0 ~ (1 << planes) - 1, bit n of level = bit-plane n
+//
+void lib_matrix::set_gray (int x, int y, unsigned char level)
+{
+    int offset = ((y / 8) * (_x_dots / 8) + (x / 8)) * 8 + (y % 8);
+    unsigned char mask = 0x80 >> (x % 8);
+
+    if (!_p_gray)
+        return;
+    for (int n = 0; n < _gray_planes; n++, offset += _fb_size) {
+        if (level & (1 << n))   _p_gray[offset] |=  mask;
+        else                    _p_gray[offset] &= ~mask;
+    }
+}
+
+//------------------------------------------------------------------------------
+unsigned char lib_matrix::get_gray (int x, int y)
+{
+    int offset = ((y / 8) * (_x_dots / 8) + (x / 8)) * 8 + (y % 8);
+    unsigned char mask = 0x80 >> (x % 8), level = 0;
+
+    if (!_p_gray)
+        return  0;
+    for (int n = 0; n < _gray_planes; n++, offset += _fb_size)
+        if (_p_gray[offset] & mask)
+            level |= (1 << n);
+    return  level;
+}
+
+//------------------------------------------------------------------------------
+// out of range area of framebuffer is filled with 0.
+//
+void lib_matrix::blit_gray (const lib_fb &fb, int x_off, int y_off)
+{
+    if (!_gray_planes)
+        return;
+
+    for (int y = 0; y < _y_dots; y++) {
+        for (int x = 0; x < _x_dots; x++) {
+            int fx = x_off + x, fy = y_off + y;
+            unsigned char level = 0;
+
+            if ((fx >= 0) && (fy >= 0) &&
+                (fx < fb.get_width()) && (fy < fb.get_height()))
+                level = _fb_luma (fb, fx, fy) >> (8 - _gray_planes);
+            set_gray (x, y, level);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void lib_matrix::blit_region (const lib_fb &fb, int x_off, int y_off,
+                                const struct disp_region *p_region)
+{
+    int num_module_x = _x_dots / 8;
+    struct disp_region r = *p_region;
+
+    align_region (&r);
+    if (!r.w || !r.h)
+        return;
+
+    for (int y = r.y; y < r.y + r.h; y++) {
+        int fy = y_off + y;
+        unsigned char *p_dst = &_p_fb[((y / 8) * num_module_x + r.x / 8) * 8 + (y % 8)];
+
+        for (int x = r.x; x < r.x + r.w; x += 8, p_dst += 8) {
+            if ((fy < 0) || (fy >= fb.get_height())) {
+                *p_dst = 0;
+                continue;
+            }
+            if (fb.get_bpp() == 1) {
+                *p_dst = _bit_reverse (fb.get_byte (x_off + x, fy));
+                continue;
+            }
+            for (int k = 0; k < 8; k++) {
+                int fx = x_off + x + k;
+                bool onoff = (fx >= 0) && (fx < fb.get_width()) && fb.get_pixel(fx, fy);
+
+                *p_dst = onoff ? (*p_dst | (0x80 >> k)) : (*p_dst & ~(0x80 >> k));
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// column byte (band) of 8 columns -> 8 module line bytes (MSB = left column)
+//
+void lib_matrix::blit_columns (const unsigned char *p_columns)
+{
+    int num_module_x = _x_dots / 8, column_bytes = (_y_dots + 7) / 8;
+
+    for (int band = 0; band < _y_dots / 8; band++) {
+        unsigned char *p_dst = &_p_fb[band * num_module_x * 8];
+
+        for (int j = 0; j < num_module_x; j++, p_dst += 8) {
+            const unsigned char *p_src = &p_columns[(j * 8) * column_bytes + band];
+            unsigned long long v = 0;
+
+            /* byte k = column (7 - k) -> transposed line bit 7 = left column */
+            for (int k = 0; k < 8; k++)
+                v |= (unsigned long long)p_src[(7 - k) * column_bytes] << (k * 8);
+            v = lib_fb::transpose8 (v);
+            for (int line = 0; line < 8; line++)
+                p_dst[line] = (unsigned char)(v >> (line * 8));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Incoming bits of a display line from column-major data.
+// p_columns : n columns (left to right), (y_dots + 7) / 8 bytes per column,
+//             bit (y % 8) of byte (y / 8) = line y.
+// return : n bits, MSB = left column.
+//
+static inline unsigned char _column_bits (const unsigned char *p_columns,
+                                        int column_bytes, int n, int y)
+{
+    unsigned char bits = 0;
+
+    if (!p_columns)
+        return  0;
+
+    p_columns += (y / 8);
+    for (int k = 0; k < n; k++, p_columns += column_bytes)
+        bits = (bits << 1) | ((*p_columns >> (y % 8)) & 0x01);
+    return  bits;
+}
+
+//------------------------------------------------------------------------------
+// Shift every display line left by n dots across the module boundaries and
+// insert the new columns at the right edge. (n : 1 ~ 8 per step)
+//
+void lib_matrix::scroll_left (int n, const unsigned char *p_new_columns)
+{
+    int num_module_x = _x_dots / 8, column_bytes = (_y_dots + 7) / 8;
+
+    while (n > 0) {
+        int step = (n > 8) ? 8 : n;
+
+        for (int y = 0; y < _y_dots; y++) {
+            unsigned char *p_line = &_p_fb[(y / 8) * num_module_x * 8 + (y % 8)];
+            unsigned int data = p_line[0];
+
+            for (int j = 0; j < num_module_x - 1; j++, p_line += 8) {
+                unsigned int next = p_line[8];
+                *p_line = (unsigned char)((data << step) | (next >> (8 - step)));
+                data = next;
+            }
+            *p_line = (unsigned char)((data << step) |
+                        _column_bits (p_new_columns, column_bytes, step, y));
+        }
+        if (p_new_columns)
+            p_new_columns += step * column_bytes;
+        n -= step;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Shift every display line right by n dots, new columns at the left edge.
+//
+void lib_matrix::scroll_right (int n, const unsigned char *p_new_columns)
+{
+    int num_module_x = _x_dots / 8, column_bytes = (_y_dots + 7) / 8;
+
+    while (n > 0) {
+        int step = (n > 8) ? 8 : n;
+
+        /* the last step brings in the first columns */
+        n -= step;
+        for (int y = 0; y < _y_dots; y++) {
+            unsigned char *p_line = &_p_fb[((y / 8) * num_module_x + num_module_x - 1) * 8 + (y % 8)];
+            unsigned int data = p_line[0];
+
+            for (int j = num_module_x - 1; j > 0; j--, p_line -= 8) {
+                unsigned int prev = p_line[-8];
+                *p_line = (unsigned char)((data >> step) | (prev << (8 - step)));
+                data = prev;
+            }
+            *p_line = (unsigned char)((data >> step) |
+                        (_column_bits (p_new_columns ? p_new_columns + n * column_bytes : NULL,
+                                        column_bytes, step, y) << (8 - step)));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Copy display line src to dst (module line bytes)
+//
+void lib_matrix::_copy_line (int dst_y, int src_y)
+{
+    int num_module_x = _x_dots / 8;
+    unsigned char *p_dst = &_p_fb[(dst_y / 8) * num_module_x * 8 + (dst_y % 8)];
+    unsigned char *p_src = &_p_fb[(src_y / 8) * num_module_x * 8 + (src_y % 8)];
+
+    for (int j = 0; j < num_module_x; j++, p_dst += 8, p_src += 8)
+        *p_dst = *p_src;
+}
+
+//------------------------------------------------------------------------------
+// p_line : x_dots / 8 bytes (MSB = left dot), NULL : clear
+//
+void lib_matrix::_set_line (int y, const unsigned char *p_line)
+{
+    int num_module_x = _x_dots / 8;
+    unsigned char *p_dst = &_p_fb[(y / 8) * num_module_x * 8 + (y % 8)];
+
+    for (int j = 0; j < num_module_x; j++, p_dst += 8)
+        *p_dst = p_line ? p_line[j] : 0;
+}
+
+//------------------------------------------------------------------------------
+// Shift the display up by n lines, new lines at the bottom.
+// p_new_lines : n lines (top to bottom), x_dots / 8 bytes per line.
+//
+void lib_matrix::scroll_up (int n, const unsigned char *p_new_lines)
+{
+    if (n <= 0)
+        return;
+    if (n > _y_dots)
+        n = _y_dots;
+    for (int y = 0; y < _y_dots - n; y++)
+        _copy_line (y, y + n);
+    for (int y = 0; y < n; y++)
+        _set_line (_y_dots - n + y, p_new_lines ? &p_new_lines[y * (_x_dots / 8)] : NULL);
+}
+
+//------------------------------------------------------------------------------
+// Shift the display down by n lines, new lines at the top.
+//
+void lib_matrix::scroll_down (int n, const unsigned char *p_new_lines)
+{
+    if (n <= 0)
+        return;
+    if (n > _y_dots)
+        n = _y_dots;
+    for (int y = _y_dots - 1; y >= n; y--)
+        _copy_line (y, y - n);
+    for (int y = 0; y < n; y++)
+        _set_line (y, p_new_lines ? &p_new_lines[y * (_x_dots / 8)] : NULL);
+}
+
 //------------------------------------------------------------------------------
 void lib_matrix::set_module_byte (int location_of_module, int line_of_module,
                                 unsigned char byte)
@@ -62,35 +481,532 @@ unsigned char lib_matrix::get_module_byte (int location_of_module,
     return _p_fb[(location_of_module * 8) + line_of_module];
 }
 
+//------------------------------------------------------------------------------
+// Write the same register value to all modules of all chains.
+// p_data : per module value (p_data[location of module]) instead of data.
+// refresh timer running : sent by the refresh timer before the next frame.
+//
+void lib_matrix::_send_cmd (unsigned char reg, unsigned char data,
+                            const unsigned char *p_data)
+{
+    unsigned char *p_buf = _refresh_us ? _p_cmd_buffer : _p_spi_buffer;
+
+    /* refresh timer running : wait for previous command */
+    while (_cmd_pending)
+        yield();
+
+    for (int c = 0; c < _num_of_chain; c++) {
+        int num_of_module = _p_chain_start[c + 1] - _p_chain_start[c];
+
+        if (_refresh_us)
+            p_buf = &_p_cmd_buffer[_p_chain_start[c] * 2];
+
+        for (int j = 0; j < num_of_module; j++) {
+            p_buf [(j * 2) + 0] = reg;
+            p_buf [(j * 2) + 1] = p_data ?
+                    p_data[_p_matrix_table[_p_chain_start[c] + j]] : data;
+        }
+        if (!_refresh_us)
+            _send_to_matrix (c, p_buf, num_of_module * 2);
+    }
+    if (_refresh_us)
+        _cmd_pending = true;
+}
+
 //------------------------------------------------------------------------------
 // brightness : 0x1 ~ 0xF
 //
 void lib_matrix::brightness (unsigned char brightness)
 {
+    /* Brightness address setup, digit data set (0x01 ~ 0x0F) */
     if (brightness && (brightness < 0x10)) {
-        for (int j = 0; j < _num_of_module; j++) {
-            /* Brightness address setup */
-            _p_spi_buffer [(j * 2) + 0] = 0x0a;
-            /* digit data set (0x01 ~ 0x0F) */
-            _p_spi_buffer [(j * 2) + 1] = brightness;
+        _fading = false;
+        _brightness = brightness;
+        if (_p_intensity)
+            memset (_p_intensity, brightness, _num_of_module);
+        _send_cmd (0x0a, brightness);
+    }
+}
+
+//------------------------------------------------------------------------------
+// intensity map [current, fade start, fade target] (current = brightness)
+//
+bool lib_matrix::_alloc_intensity ()
+{
+    if (!_p_intensity) {
+        unsigned char *p_mem = new unsigned char [_num_of_module * 3];
+
+        if (!p_mem)
+            return  false;
+        memset (p_mem, _brightness, _num_of_module * 3);
+        _p_fade_from = &p_mem[_num_of_module];
+        _p_fade_to   = &p_mem[_num_of_module * 2];
+        _p_intensity = p_mem;
+    }
+    return  true;
+}
+
+//------------------------------------------------------------------------------
+// p_intensity[location of module] : 0x0 ~ 0xF
+//
+void lib_matrix::set_intensity (const unsigned char *p_intensity)
+{
+    if (!_alloc_intensity ())
+        return;
+
+    _fading = false;
+    for (int i = 0; i < _num_of_module; i++)
+        _p_intensity[i] = p_intensity[i] & 0x0F;
+    _send_cmd (0x0a, 0, _p_intensity);
+}
+
+//------------------------------------------------------------------------------
+void lib_matrix::set_intensity (int location_of_module, unsigned char intensity)
+{
+    if ((location_of_module < 0) || (location_of_module >= _num_of_module))
+        return;
+    if (!_alloc_intensity ())
+        return;
+
+    _fading = false;
+    _p_intensity[location_of_module] = intensity & 0x0F;
+    _send_cmd (0x0a, 0, _p_intensity);
+}
+
+//------------------------------------------------------------------------------
+unsigned char lib_matrix::get_intensity (int location_of_module)
+{
+    if ((location_of_module < 0) || (location_of_module >= _num_of_module))
+        return  0;
+    return  _p_intensity ? _p_intensity[location_of_module] : _brightness;
+}
+
+//------------------------------------------------------------------------------
+// p_intensity : target level of each module, NULL : keep _p_fade_to
+//
+void lib_matrix::fade_to (const unsigned char *p_intensity, unsigned long fade_ms)
+{
+    if (!_alloc_intensity ())
+        return;
+
+    if (p_intensity) {
+        for (int i = 0; i < _num_of_module; i++)
+            _p_fade_to[i] = p_intensity[i] & 0x0F;
+    }
+    memcpy (_p_fade_from, _p_intensity, _num_of_module);
+    _fade_start_ms = millis();
+    _fade_ms = fade_ms;
+    _fading  = true;
+    fade_loop ();
+}
+
+//------------------------------------------------------------------------------
+void lib_matrix::fade_to (unsigned char intensity, unsigned long fade_ms)
+{
+    if (!_alloc_intensity ())
+        return;
+
+    memset (_p_fade_to, intensity & 0x0F, _num_of_module);
+    fade_to ((const unsigned char *)NULL, fade_ms);
+}
+
+//------------------------------------------------------------------------------
+// linear ramp of the intensity registers. (16 levels, sent only on change)
+// return : true = fade in progress
+//
+bool lib_matrix::fade_loop ()
+{
+    unsigned long elapsed_ms;
+    bool changed = false;
+
+    if (!_fading)
+        return  false;
+
+    elapsed_ms = millis() - _fade_start_ms;
+    if (elapsed_ms >= _fade_ms)
+        _fading = false;
+
+    for (int i = 0; i < _num_of_module; i++) {
+        int from = _p_fade_from[i], to = _p_fade_to[i];
+        unsigned char level = _fading ?
+                from + (to - from) * (long)elapsed_ms / (long)_fade_ms : to;
+
+        if (_p_intensity[i] != level) {
+            _p_intensity[i] = level;
+            changed = true;
         }
-        _send_to_matrix();
     }
+    if (changed)
+        _send_cmd (0x0a, 0, _p_intensity);
+    return  _fading;
 }
 
 //------------------------------------------------------------------------------
-void lib_matrix::update ()
+// orient : MATRIX_ROT_xx | MATRIX_MIRROR_x. applied to the module image on update.
+//
+void lib_matrix::set_orientation (int location_of_module, unsigned char orient)
+{
+    if ((location_of_module < 0) || (location_of_module >= _num_of_module))
+        return;
+
+    if (!_p_orient) {
+        unsigned char *p_orient;
+
+        if (!orient)
+            return;
+        /* refresh timer checks _p_orient, so set it last */
+        p_orient   = new unsigned char [_num_of_module];
+        memset (p_orient, 0, _num_of_module);
+        _p_fb_wire = new unsigned char [_fb_size];
+        _p_orient  = p_orient;
+    }
+    _p_orient[location_of_module] = orient;
+    _fb_sent_valid = false;
+}
+
+//------------------------------------------------------------------------------
+void lib_matrix::set_orientation (unsigned char orient)
+{
+    for (int i = 0; i < _num_of_module; i++)
+        set_orientation (i, orient);
+}
+
+//------------------------------------------------------------------------------
+// Module images as sent to the matrix. (orientation applied)
+//
+const unsigned char * IRAM_ATTR lib_matrix::_apply_orient (const unsigned char *p_src)
+{
+    if (!_p_orient)
+        return  p_src;
+
+    for (int i = 0; i < _num_of_module; i++) {
+        uint64_t data = _module_load (&p_src[i * 8]);
+
+        if (_p_orient[i])
+            data = _module_orient (data, _p_orient[i]);
+        _module_store (&_p_fb_wire[i * 8], data);
+    }
+    return  _p_fb_wire;
+}
+
+//------------------------------------------------------------------------------
+// Make one digit line transaction of a chain.
+// return false if nothing changed in the line of the chain.
+// Unchanged module in a dirty line gets the No-Op register(0x00).
+//
+bool IRAM_ATTR lib_matrix::_make_line (int line, int chain,
+                                const unsigned char *p_src, unsigned char *p_buf)
 {
+    const unsigned short *p_table = &_p_matrix_table[_p_chain_start[chain]];
+    int num_of_module = _p_chain_start[chain + 1] - _p_chain_start[chain];
+    bool line_dirty = false;
+
+    for (int j = 0; j < num_of_module; j++) {
+        int offset = p_table[j] * 8 + line;
+
+        if (_fb_sent_valid && (_p_fb_sent[offset] == p_src[offset])) {
+            /* No-Op register */
+            p_buf [(j * 2) + 0] = 0x00;
+            p_buf [(j * 2) + 1] = 0x00;
+            continue;
+        }
+        /* digit line number set (1-8) */
+        p_buf [(j * 2) + 0] = line +1;
+        /* digit line data set */
+        p_buf [(j * 2) + 1] = p_src[offset];
+        _p_fb_sent[offset] = p_src[offset];
+        line_dirty = true;
+    }
+    return  line_dirty;
+}
+
+//------------------------------------------------------------------------------
+void IRAM_ATTR lib_matrix::_add_tx (int chain, int offset)
+{
+    struct matrix_tx *p_tx = &_p_tx_list[_tx_lines];
+
+    p_tx->chain  = chain;
+    p_tx->offset = offset;
+    p_tx->bytes  = (_p_chain_start[chain + 1] - _p_chain_start[chain]) * 2;
+    _tx_lines = _tx_lines + 1;
+}
+
+//------------------------------------------------------------------------------
+// Fill the async transaction list.
+// (pending command lines + dirty digit lines of the dirty chains)
+//
+int IRAM_ATTR lib_matrix::_stage_lines (const unsigned char *p_src)
+{
+    int pos = 0;
+
+    p_src = _apply_orient (p_src);
+    _tx_lines = 0;
+    if (_cmd_pending) {
+        for (int i = 0; i < _num_of_module * 2; i++)
+            _p_tx_buffer[i] = _p_cmd_buffer[i];
+        for (int c = 0; c < _num_of_chain; c++)
+            _add_tx (c, _p_chain_start[c] * 2);
+        pos = _num_of_module * 2;
+        _cmd_pending = false;
+    }
+    for (int i = 0; i < 8; i++)  {
+        for (int c = 0; c < _num_of_chain; c++) {
+            if (_make_line (i, c, p_src, &_p_tx_buffer[pos])) {
+                _add_tx (c, pos);
+                pos += _p_tx_list[_tx_lines - 1].bytes;
+            }
+        }
+    }
+    _fb_sent_valid = true;
+    return  _tx_lines;
+}
+
+//------------------------------------------------------------------------------
+// Only the changed digit rows of the changed chains are sent.
+//
+void lib_matrix::_update (const unsigned char *p_src)
+{
+    _wait_tx_done ();
+    p_src = _apply_orient (p_src);
     for (int i = 0; i < 8; i++)  {
-        for (int j = 0; j < _num_of_module; j++) {
-            /* digit line number set (1-8) */
-            _p_spi_buffer [(j * 2) + 0] = i +1;
-            /* digit line data set */
-            _p_spi_buffer [(j * 2) + 1] = _p_fb[_p_matrix_table[j] * 8 + i];
+        for (int c = 0; c < _num_of_chain; c++) {
+            if (_make_line (i, c, p_src, _p_spi_buffer))
+                _send_to_matrix (c, _p_spi_buffer,
+                        (_p_chain_start[c + 1] - _p_chain_start[c]) * 2);
         }
-        _send_to_matrix();
     }
-    Serial.printf("%d %d\r\n",_spi_send_bytes, _num_of_module);
+    _fb_sent_valid = true;
+}
+
+//------------------------------------------------------------------------------
+void lib_matrix::update ()
+{
+    if (_refresh_us)
+        present ();
+    else
+        _update (_p_fb);
+}
+
+//------------------------------------------------------------------------------
+// Stage the dirty lines and return. The lines are sent from timer1 interrupt.
+// (refresh timer running : same as present())
+//
+void lib_matrix::update_async ()
+{
+    if (_refresh_us) {
+        present ();
+        return;
+    }
+    _wait_tx_done ();
+
+    if (!_stage_lines (_p_fb)) {
+        if (_tx_done_cb)
+            _tx_done_cb (_tx_done_arg);
+        return;
+    }
+#if defined(ESP8266)
+    if (!_p_spi) {
+        _p_tx_owner = this;
+        timer1_attachInterrupt (_tx_isr);
+        timer1_enable (TIM_DIV16, TIM_EDGE, TIM_SINGLE);
+        _tx_start ();
+        return;
+    }
+#endif
+    /* matrix_spi transport : send now */
+    for (int i = 0; i < _tx_lines; i++)
+        _send_to_matrix (_p_tx_list[i].chain,
+                        &_p_tx_buffer[_p_tx_list[i].offset], _p_tx_list[i].bytes);
+    if (_tx_done_cb)
+        _tx_done_cb (_tx_done_arg);
+}
+
+//------------------------------------------------------------------------------
+// Exchange draw(back) buffer and display(front) buffer.
+//
+void lib_matrix::swap ()
+{
+    unsigned char *p_fb;
+
+    noInterrupts();
+    p_fb = _p_fb;   _p_fb = _p_fb_front;    _p_fb_front = p_fb;
+    interrupts();
+}
+
+//------------------------------------------------------------------------------
+// Show the draw buffer. The draw buffer keeps its contents after present().
+// refresh timer running : wait until the previous frame has been picked up,
+// so present() is called at most once per refresh period.
+//
+void lib_matrix::present (const struct disp_region *p_region)
+{
+    if (_gray_planes) {
+        present_gray ();
+        return;
+    }
+    while (_swap_pending)
+        yield();
+
+    swap ();
+    memcpy (_p_fb, _p_fb_front, _fb_size);
+
+    if (_refresh_us)
+        _swap_pending = true;
+    else
+        _update (_p_fb_front);
+}
+
+//------------------------------------------------------------------------------
+// Send the front buffer fps times per second from timer1 interrupt.
+//
+void lib_matrix::start_refresh (unsigned int fps)
+{
+#if defined(ESP8266)
+    /* H/W SPI only */
+    if (!fps || _p_spi)
+        return;
+    stop_refresh ();
+
+    memcpy (_p_fb_front, _p_fb, _fb_size);
+    _swap_pending = false;
+    _refresh_us   = 1000000UL / fps;
+
+    _p_tx_owner = this;
+    timer1_attachInterrupt (_tx_isr);
+    timer1_enable (TIM_DIV16, TIM_EDGE, TIM_SINGLE);
+    timer1_write (TX_POLL_TICKS);
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Show the gray planes from the next modulation cycle.
+//
+void lib_matrix::present_gray ()
+{
+    if (!_gray_planes)
+        return;
+    while (_swap_pending)
+        yield();
+
+    memcpy (_p_gray_next, _p_gray, _gray_planes * _fb_size);
+    _swap_pending = true;
+}
+
+//------------------------------------------------------------------------------
+// Bit-planes are pushed one per frame from the refresh timer.
+// A cycle takes (2^planes - 1) * unit_us, unit_us must cover one frame push.
+//
+bool lib_matrix::start_gray (int planes, unsigned long unit_us)
+{
+#if defined(ESP8266)
+    int size;
+
+    /* H/W SPI only */
+    if ((planes < 1) || (planes > MATRIX_GRAY_PLANES_MAX) || _p_spi)
+        return  false;
+    stop_refresh ();
+
+    if (unit_us < get_push_us ())
+        unit_us = get_push_us ();
+
+    /* draw, front, next planes */
+    size = planes * _fb_size;
+    if (_p_gray)
+        delete[]    _p_gray;
+    _p_gray = new unsigned char [size * 3];
+    if (!_p_gray)
+        return  false;
+    memset (_p_gray, 0x00, size * 3);
+    _p_gray_front = &_p_gray[size];
+    _p_gray_next  = &_p_gray[size * 2];
+
+    _gray_planes  = planes;
+    _gray_plane   = 0;
+    _swap_pending = false;
+    _refresh_us   = unit_us;
+
+    _p_tx_owner = this;
+    timer1_attachInterrupt (_tx_isr);
+    timer1_enable (TIM_DIV16, TIM_EDGE, TIM_SINGLE);
+    timer1_write (TX_POLL_TICKS);
+    return  true;
+#else
+    return  false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// back to the on/off display of the draw buffer.
+//
+void lib_matrix::stop_gray ()
+{
+    if (!_gray_planes)
+        return;
+    stop_refresh ();
+    _gray_planes = 0;
+    refresh ();
+}
+
+//------------------------------------------------------------------------------
+// Full frame push time (all digit lines of all chains) of the refresh timer.
+// Estimate : SPI clock time + FIFO reload delay, interrupt latency and the
+// line staging time are not included. (measure_push_us() for the real value)
+//
+unsigned long lib_matrix::get_push_us ()
+{
+    unsigned long ticks = 0;
+
+    for (int c = 0; c < _num_of_chain; c++) {
+        int bytes = (_p_chain_start[c + 1] - _p_chain_start[c]) * 2;
+        int chunks = (bytes + SPI_FIFO_BYTES - 1) / SPI_FIFO_BYTES;
+
+        ticks += bytes * _tx_ticks_per_byte + (chunks + 1) * TX_POLL_TICKS;
+    }
+    /* 8 digit lines, TIM_DIV16 : 5 ticks = 1us */
+    return  (ticks * 8 + 4) / 5;
+}
+
+//------------------------------------------------------------------------------
+// Time a forced full frame update on the board. (refresh timer must be
+// stopped, while it runs the get_push_us() estimate is returned)
+//
+unsigned long lib_matrix::measure_push_us ()
+{
+    unsigned long start_us;
+
+    if (_refresh_us)
+        return  get_push_us ();
+
+    _wait_tx_done ();
+    _fb_sent_valid = false;
+    start_us = micros();
+    update_async ();
+    _wait_tx_done ();
+    return  micros() - start_us;
+}
+
+//------------------------------------------------------------------------------
+void lib_matrix::stop_refresh ()
+{
+#if defined(ESP8266)
+    if (!_refresh_us)
+        return;
+
+    _refresh_us = 0;
+    noInterrupts();
+    if (!_tx_busy)
+        timer1_disable ();
+    interrupts();
+
+    _wait_tx_done ();
+    _swap_pending = false;
+    if (_cmd_pending) {
+        for (int c = 0; c < _num_of_chain; c++)
+            _send_to_matrix (c, &_p_cmd_buffer[_p_chain_start[c] * 2],
+                        (_p_chain_start[c + 1] - _p_chain_start[c]) * 2);
+        _cmd_pending = false;
+    }
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -99,91 +1015,480 @@ void lib_matrix::_init (unsigned long spi_freq, bool hw_cs)
     int cmd_cnt = sizeof(_InitCmd)/sizeof(_InitCmd[0]);
 
     delay(1000);
-    /* SPI init */
-    SPI.begin();
-    SPI.setFrequency(spi_freq);
-    SPI.setHwCs(hw_cs);
+    if (_p_spi) {
+        /* matrix_spi transport (CS is controlled by the transport) */
+        _hw_cs = false;
+        _p_spi->begin (spi_freq);
+        for (int c = 0; c < _num_of_chain; c++)
+            _p_spi->cs_init (_p_chain_cs[c]);
+    } else {
+#if defined(ARDUINO)
+        /* SPI init */
+        SPI.begin();
+        SPI.setFrequency(spi_freq);
+
+        /*
+            H/W CS is toggled on every FIFO(64 bytes) transfer and only on SS pin.
+            Longer chain or multi chain must keep CS low for the whole line,
+            so use GPIO CS.
+        */
+        _hw_cs = hw_cs && (_num_of_chain == 1) && (_p_chain_cs[0] == SS) &&
+                (_num_of_module * 2 <= SPI_FIFO_BYTES);
+        SPI.setHwCs(_hw_cs);
+        if (!_hw_cs) {
+            for (int c = 0; c < _num_of_chain; c++) {
+                pinMode (_p_chain_cs[c], OUTPUT);
+                _cs_write (c, HIGH);
+            }
+        }
+#endif
+    }
+    // timer1 (TIM_DIV16 : 5 ticks / 1us) ticks for 1 byte transfer
+    _tx_ticks_per_byte = (8 * 5000000UL + spi_freq - 1) / spi_freq;
 
     /* dummy data send */
     delay(100);
-    memset (_p_spi_buffer, 0, _spi_send_bytes); _send_to_matrix ();
+    _send_cmd (0x00, 0x00);
     delay(100);
 
-    for (int i = 0; i < cmd_cnt; i++)  {
-        for (int j = 0; j < _num_of_module; j++) {
-            _p_spi_buffer[(j * 2) + 0] = _InitCmd[i][0];
-            _p_spi_buffer[(j * 2) + 1] = _InitCmd[i][1];
-        }
-        _send_to_matrix();
+    for (int i = 0; i < cmd_cnt; i++) {
+        _send_cmd (_InitCmd[i][0], _InitCmd[i][1]);
+        if (_InitCmd[i][0] == 0x0a)
+            _brightness = _InitCmd[i][1];
     }
     delay(100);
 #if 0
-    for (int i = 0; i < cmd_cnt; i++)  {
-        for (int j = 0; j < _num_of_module; j++) {
-            _p_spi_buffer[(j * 2) + 0] = _InitCmd[i][0];
-            _p_spi_buffer[(j * 2) + 1] = _InitCmd[i][1];
-        }
-        _send_to_matrix();
-    }
+    for (int i = 0; i < cmd_cnt; i++)
+        _send_cmd (_InitCmd[i][0], _InitCmd[i][1]);
     delay(100);
 #endif
     memset (_p_fb, 0x00, _fb_size);
-    update();
+    memset (_p_fb_front, 0x00, _fb_size);
+    refresh();
+}
+
+//------------------------------------------------------------------------------
+void IRAM_ATTR lib_matrix::_cs_write (int chain, int level)
+{
+    int cs_pin = _p_chain_cs[chain];
+
+    if (_p_spi) {
+        _p_spi->cs_write (cs_pin, level);
+        return;
+    }
+    if (_hw_cs)
+        return;
+#if defined(ESP8266)
+    if (cs_pin < 16) {
+        if (level)  GPOS = (1 << cs_pin);
+        else        GPOC = (1 << cs_pin);
+        return;
+    }
+#endif
+#if defined(ARDUINO)
+    digitalWrite (cs_pin, level);
+#endif
+}
+
+//------------------------------------------------------------------------------
+void lib_matrix::_wait_tx_done ()
+{
+    while (_tx_busy)
+        yield();
+}
+
+//------------------------------------------------------------------------------
+// MAX7219 latches data on the CS rising edge. (CS high pulse min 50ns)
+// SPI.writeBytes returns after the transfer is complete, so no delay is needed.
+//
+void lib_matrix::_send_to_matrix (int chain, const unsigned char *p_buf, int bytes)
+{
+    _wait_tx_done ();
+    if (p_buf && bytes) {
+        _cs_write (chain, LOW);
+        if (_p_spi)
+            _p_spi->write (p_buf, bytes);
+#if defined(ARDUINO)
+        else
+            SPI.writeBytes((uint8_t *)p_buf, bytes);
+#endif
+        _cs_write (chain, HIGH);
+        _tx_bytes += bytes;
+    }
+}
+
+#if defined(ESP8266)
+//------------------------------------------------------------------------------
+// async update engine (timer1 single shot interrupt)
+//------------------------------------------------------------------------------
+lib_matrix *lib_matrix::_p_tx_owner = NULL;
+
+//------------------------------------------------------------------------------
+// SPI transfer in progress : next FIFO chunk, otherwise : refresh frame timing
+//
+void IRAM_ATTR lib_matrix::_tx_isr ()
+{
+    if (!_p_tx_owner)
+        return;
+    if (_p_tx_owner->_tx_busy)
+        _p_tx_owner->_tx_service ();
+    else
+        _p_tx_owner->_frame_start ();
+}
+
+//------------------------------------------------------------------------------
+void IRAM_ATTR lib_matrix::_tx_start ()
+{
+    _tx_line = 0;   _tx_pos = 0;    _tx_busy = true;
+    _tx_service ();
 }
 
 //------------------------------------------------------------------------------
-void lib_matrix::_send_to_matrix ()
+// refresh frame : send the dirty lines of the front buffer.
+//
+void IRAM_ATTR lib_matrix::_frame_start ()
 {
-    if (_p_spi_buffer && _spi_send_bytes)
-        SPI.transfer(_p_spi_buffer, _spi_send_bytes);
+    const unsigned char *p_src = _p_fb_front;
+
+    if (!_refresh_us)
+        return;
+
+    _frame_start_us = micros();
+    _frame_us = _refresh_us;
+    if (_gray_planes) {
+        /* the presented planes are picked up at the start of a cycle */
+        if (!_gray_plane && _swap_pending) {
+            unsigned char *p_gray = _p_gray_front;
 
-    delay(1);
+            _p_gray_front = _p_gray_next;   _p_gray_next = p_gray;
+            _swap_pending = false;
+        }
+        /* bit-angle modulation : plane n is shown for (unit << n) */
+        p_src = &_p_gray_front[_gray_plane * _fb_size];
+        _frame_us = _refresh_us << _gray_plane;
+        if (++_gray_plane >= _gray_planes)
+            _gray_plane = 0;
+    } else {
+        /* the presented frame is picked up */
+        _swap_pending = false;
+    }
+
+    if (_stage_lines (p_src))
+        _tx_start ();
+    else
+        _frame_next ();
 }
 
 //------------------------------------------------------------------------------
+// timer1 setup for the next refresh frame.
+//
+void IRAM_ATTR lib_matrix::_frame_next ()
+{
+    unsigned long elapsed_us = micros() - _frame_start_us, ticks = TX_POLL_TICKS;
+
+    if (!_refresh_us)
+        return;
+    if (elapsed_us < _frame_us)
+        ticks = (_frame_us - elapsed_us) * 5;
+    timer1_write (ticks);
+}
+
+//------------------------------------------------------------------------------
+// Load the next FIFO chunk of the current line transaction.
+// GPIO CS is released after the last chunk of the line (latch).
+//
+void IRAM_ATTR lib_matrix::_tx_service ()
+{
+    const struct matrix_tx *p_tx = &_p_tx_list[_tx_line];
+    const unsigned char *p_data;
+    volatile uint32_t *p_fifo = &SPI1W0;
+    int send_bytes, i;
+
+    if (SPI1CMD & SPIBUSY) {
+        timer1_write (TX_POLL_TICKS);
+        return;
+    }
+    if (_tx_pos >= p_tx->bytes) {
+        /* line latch */
+        _cs_write (p_tx->chain, HIGH);
+        _tx_line = _tx_line + 1;
+        _tx_pos  = 0;
+        if (_tx_line >= _tx_lines) {
+            _tx_busy = false;
+            if (_tx_done_cb)
+                _tx_done_cb (_tx_done_arg);
+            _frame_next ();
+            return;
+        }
+        p_tx++;
+    }
+    if (!_tx_pos)
+        _cs_write (p_tx->chain, LOW);
+
+    send_bytes = p_tx->bytes - _tx_pos;
+    if (send_bytes > SPI_FIFO_BYTES)
+        send_bytes = SPI_FIFO_BYTES;
+
+    p_data = &_p_tx_buffer[p_tx->offset + _tx_pos];
+    for (i = 0; i < send_bytes; i += 4) {
+        uint32_t data = p_data[i];
+        if (i + 1 < send_bytes) data |= (uint32_t)p_data[i + 1] <<  8;
+        if (i + 2 < send_bytes) data |= (uint32_t)p_data[i + 2] << 16;
+        if (i + 3 < send_bytes) data |= (uint32_t)p_data[i + 3] << 24;
+        p_fifo[i / 4] = data;
+    }
+    SPI1U1 = (SPI1U1 & ~((SPIMMOSI << SPILMOSI) | (SPIMMISO << SPILMISO))) |
+            (((send_bytes * 8) - 1) << SPILMOSI) |
+            (((send_bytes * 8) - 1) << SPILMISO);
+    SPI1CMD |= SPIBUSY;
+
+    _tx_pos   = _tx_pos + send_bytes;
+    _tx_bytes += send_bytes;
+    timer1_write (send_bytes * _tx_ticks_per_byte + TX_POLL_TICKS);
+}
+#endif
+
+//------------------------------------------------------------------------------
+// No matrix yet. begin() sets up the matrix later. (ex: layout file)
+//
 lib_matrix::lib_matrix (/* args */)
 {
-    // default setup
-    lib_matrix(8, 8, NULL);
+    _clear ();
 }
 
 //------------------------------------------------------------------------------
 lib_matrix::lib_matrix (int x_dots, int y_dots, const unsigned char *matrix_table,
-                        unsigned long spi_freq, bool hw_cs)
+                        unsigned long spi_freq, bool hw_cs, int cs_pin,
+                        matrix_spi *p_spi)
 {
+    _clear ();
+    begin (x_dots, y_dots, matrix_table, spi_freq, hw_cs, cs_pin, p_spi);
+}
+
+//------------------------------------------------------------------------------
+lib_matrix::lib_matrix (int x_dots, int y_dots, const struct matrix_chain *chains,
+                        int num_of_chain, unsigned long spi_freq,
+                        matrix_spi *p_spi)
+{
+    _clear ();
+    begin (x_dots, y_dots, chains, num_of_chain, spi_freq, p_spi);
+}
+
+//------------------------------------------------------------------------------
+// single chain. matrix_table[chain position] = module location
+//
+void lib_matrix::begin (int x_dots, int y_dots, const unsigned char *matrix_table,
+                        unsigned long spi_freq, bool hw_cs, int cs_pin,
+                        matrix_spi *p_spi)
+{
+    struct matrix_chain chain;
+    int num_of_module = x_dots * y_dots / _DotsOfOneModule;
+    unsigned short *p_table = new unsigned short [num_of_module];
+
+    for (int i = 0; i < num_of_module; i++)
+        p_table[i] = (matrix_table != NULL) ? matrix_table[i] : i;
+
+    chain.cs_pin        = cs_pin;
+    chain.num_of_module = num_of_module;
+    chain.matrix_table  = p_table;
+
+    _release ();
+    _p_spi = p_spi;
+    _setup (x_dots, y_dots, &chain, 1, NULL);
+    delete[]    p_table;
+
+    // SPI H/W init, Matrix Module init
+    _init (spi_freq, hw_cs);
+}
+
+//------------------------------------------------------------------------------
+// multi chain. chains share the SPI bus(SCK, MOSI) with own CS GPIO.
+//
+void lib_matrix::begin (int x_dots, int y_dots, const struct matrix_chain *chains,
+                        int num_of_chain, unsigned long spi_freq,
+                        matrix_spi *p_spi)
+{
+    _release ();
+    _p_spi = p_spi;
+    _setup (x_dots, y_dots, chains, num_of_chain, NULL);
+
+    // SPI H/W init, Matrix Module init
+    _init (spi_freq, false);
+}
+
+//------------------------------------------------------------------------------
+// layout file tables (chains, module map, orientation, brightness)
+//
+void lib_matrix::begin (const matrix_layout &layout, matrix_spi *p_spi)
+{
+    begin (layout.get_x_dots(), layout.get_y_dots(), layout.get_chains(),
+            layout.get_num_of_chain(), layout.get_spi_freq(), p_spi);
+
+    for (int i = 0; i < _num_of_module; i++)
+        set_orientation (i, layout.get_orientation (i));
+    if (layout.get_brightness ())
+        brightness (layout.get_brightness ());
+    refresh ();
+}
+
+//------------------------------------------------------------------------------
+// buffers are given by the derived class. (lib_matrix_t static buffers)
+//
+lib_matrix::lib_matrix (int x_dots, int y_dots, const struct matrix_chain *chains,
+                        int num_of_chain, unsigned long spi_freq, bool hw_cs,
+                        matrix_spi *p_spi, const struct matrix_mem *p_mem)
+{
+    _p_spi = p_spi;
+    _setup (x_dots, y_dots, chains, num_of_chain, p_mem);
+
+    // SPI H/W init, Matrix Module init
+    _init (spi_freq, hw_cs);
+}
+
+//------------------------------------------------------------------------------
+void lib_matrix::_setup (int x_dots, int y_dots, const struct matrix_chain *chains,
+                        int num_of_chain, const struct matrix_mem *p_mem)
+{
+    int max_chain_module = 0;
+
     _x_dots = x_dots;    _y_dots = y_dots;
     // calculate num of module (module bits 64)
     _num_of_module      = _x_dots * _y_dots / _DotsOfOneModule;
     _num_of_module_line = _y_dots / 8;
 
-    if ((_p_matrix_table = new unsigned char[_num_of_module])!= NULL) {
-        for (int i = 0; i < _num_of_module; i++) {
-            _p_matrix_table[i] = (matrix_table != NULL) ? matrix_table[i] : i;
-//            _p_matrix_table[i] = i;
+    // chain info : chain modules = _p_matrix_table[start[c] ~ start[c+1]-1]
+    _num_of_chain   = num_of_chain;
+    _own_mem        = (p_mem == NULL);
+    _p_chain_cs     = _own_mem ? new int [_num_of_chain]      : p_mem->p_chain_cs;
+    _p_chain_start  = _own_mem ? new int [_num_of_chain + 1]  : p_mem->p_chain_start;
+    _p_matrix_table = _own_mem ? new unsigned short [_num_of_module] :
+                                    p_mem->p_matrix_table;
+
+    _p_chain_start[0] = 0;
+    for (int c = 0; c < _num_of_chain; c++) {
+        int start = _p_chain_start[c];
+
+        _p_chain_cs[c] = chains[c].cs_pin;
+        /* lib_matrix_t : map is already in the table */
+        for (int i = 0; (chains[c].matrix_table != &_p_matrix_table[start]) &&
+                        (i < chains[c].num_of_module) &&
+                        (start + i < _num_of_module); i++) {
+            _p_matrix_table[start + i] = (chains[c].matrix_table != NULL) ?
+                                            chains[c].matrix_table[i] : start + i;
         }
+        _p_chain_start[c + 1] = start + chains[c].num_of_module;
+        if (_p_chain_start[c + 1] > _num_of_module)
+            _p_chain_start[c + 1] = _num_of_module;
+        if (chains[c].num_of_module > max_chain_module)
+            max_chain_module = chains[c].num_of_module;
     }
     // Send to Matrix buffer via SPI. Data format [Address, Data] * num of module
-    _spi_send_bytes = _num_of_module * 2;
-    _p_spi_buffer   = new unsigned char [_spi_send_bytes];
+    _spi_send_bytes = max_chain_module * 2;
+    // async update buffer (command line + 8 digit lines of all chains)
+    if (_own_mem) {
+        _p_spi_buffer   = new unsigned char [_spi_send_bytes];
+        _p_tx_buffer    = new unsigned char [_num_of_module * 2 * 9];
+        _p_tx_list      = new struct matrix_tx [_num_of_chain * 9];
+        _p_cmd_buffer   = new unsigned char [_num_of_module * 2];
+    } else {
+        _p_spi_buffer   = p_mem->p_spi_buffer;
+        _p_tx_buffer    = p_mem->p_tx_buffer;
+        _p_tx_list      = p_mem->p_tx_list;
+        _p_cmd_buffer   = p_mem->p_cmd_buffer;
+    }
+    _tx_lines = _tx_line = _tx_pos = 0;
+    _tx_busy  = false;
+    _tx_done_cb = NULL;     _tx_done_arg = NULL;
+    _cmd_pending = false;
+    // refresh timer off
+    _refresh_us = 0;        _swap_pending = false;
 
     // matrix data save buffer (One module requires 8 bytes.)
     _fb_size = _num_of_module * 8;
     // _p_fb[module number][column bits of module]
-    _p_fb = new unsigned char [_fb_size];
+    _p_fb       = _own_mem ? new unsigned char [_fb_size] : p_mem->p_fb;
+    _p_fb_sent  = _own_mem ? new unsigned char [_fb_size] : p_mem->p_fb_sent;
+    _p_fb_front = _own_mem ? new unsigned char [_fb_size] : p_mem->p_fb_front;
+    _fb_sent_valid = false;
+    _tx_bytes = 0;
 
-    // SPI H/W init, Matrix Module init
-    _init (spi_freq, hw_cs);
+    // module orientation (allocated on first use)
+    _p_orient = NULL;   _p_fb_wire = NULL;
+
+    // grayscale planes (allocated by start_gray)
+    _gray_planes = _gray_plane = 0;     _frame_us = 0;
+    _p_gray = _p_gray_front = _p_gray_next = NULL;
+
+    // module intensity (allocated on first use)
+    _brightness  = 0x01;
+    _p_intensity = _p_fade_from = _p_fade_to = NULL;
+    _fade_start_ms = _fade_ms = 0;
+    _fading = false;
+}
+
+//------------------------------------------------------------------------------
+// Nothing allocated, nothing running.
+//
+void lib_matrix::_clear ()
+{
+    _x_dots = _y_dots = 0;
+    _num_of_module = _num_of_module_line = _num_of_chain = _fb_size = 0;
+    _own_mem = false;
+    _p_spi   = NULL;
+    _p_matrix_table = NULL;     _p_chain_cs = _p_chain_start = NULL;
+    _p_spi_buffer = _p_tx_buffer = _p_cmd_buffer = NULL;
+    _p_tx_list = NULL;
+    _p_fb = _p_fb_sent = _p_fb_front = NULL;
+    _p_orient = _p_fb_wire = NULL;
+    _p_intensity = _p_fade_from = _p_fade_to = NULL;
+    _p_gray = _p_gray_front = _p_gray_next = NULL;
+    _gray_planes = _gray_plane = 0;
+    _tx_busy = false;   _cmd_pending = false;   _fading = false;
+    _refresh_us = 0;    _swap_pending = false;
+}
+
+//------------------------------------------------------------------------------
+void lib_matrix::_release ()
+{
+    stop_refresh ();
+    _wait_tx_done ();
+    if (_p_orient)
+        delete[]    _p_orient;
+    if (_p_fb_wire)
+        delete[]    _p_fb_wire;
+    if (_p_intensity)
+        delete[]    _p_intensity;
+    if (_p_gray)
+        delete[]    _p_gray;
+    if (_own_mem) {
+        if (_p_matrix_table)
+            delete[]    _p_matrix_table;
+        if (_p_chain_cs)
+            delete[]    _p_chain_cs;
+        if (_p_chain_start)
+            delete[]    _p_chain_start;
+        if (_p_spi_buffer)
+            delete[]    _p_spi_buffer;
+        if (_p_tx_buffer)
+            delete[]    _p_tx_buffer;
+        if (_p_tx_list)
+            delete[]    _p_tx_list;
+        if (_p_cmd_buffer)
+            delete[]    _p_cmd_buffer;
+        if (_p_fb)
+            delete[]    _p_fb;
+        if (_p_fb_sent)
+            delete[]    _p_fb_sent;
+        if (_p_fb_front)
+            delete[]    _p_fb_front;
+    }
+    _clear ();
 }
 
 //------------------------------------------------------------------------------
 lib_matrix::~lib_matrix ()
 {
-    if (_p_matrix_table)
-        delete[]    _p_matrix_table;
-    if (_p_spi_buffer)
-        delete[]    _p_spi_buffer;
-    if (_p_fb)
-        delete[]    _p_fb;
+    _release ();
 }
 
 //------------------------------------------------------------------------------
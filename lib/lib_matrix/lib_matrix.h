@@ -18,10 +18,98 @@
 #ifndef __LIB_MATRIX_H__
 #define __LIB_MATRIX_H__
 
+#if defined(ARDUINO)
 #include <Arduino.h>
+#else
+/* host build : matrix_spi transport(max7219_emu) only */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#define IRAM_ATTR
+#define PROGMEM
+#define pgm_read_byte(addr)     (*(const unsigned char *)(addr))
+#define LOW     0
+#define HIGH    1
+#define SS      15
+#endif
+
+#include <lib_display.h>
+
+class lib_fb;
+class matrix_layout;
+//------------------------------------------------------------------------------
+// update_async() done callback. (called in the timer1 interrupt, IRAM_ATTR)
+typedef void (*matrix_cb_t) (void *arg);
+
+// ESP8266 H/W SPI FIFO size (SPI1W0 ~ SPI1W15)
+#define SPI_FIFO_BYTES      64
+
+// Module orientation (module image is mirrored, then rotated clockwise)
+#define MATRIX_ROT_0        0x00
+#define MATRIX_ROT_90       0x01
+#define MATRIX_ROT_180      0x02
+#define MATRIX_ROT_270      0x03
+#define MATRIX_ROT_MASK     0x03
+#define MATRIX_MIRROR_X     0x04
+#define MATRIX_MIRROR_Y     0x08
+
+// grayscale bit-planes (bit-angle modulation)
+#define MATRIX_GRAY_PLANES_MAX  4
+
+//------------------------------------------------------------------------------
+// Daisy chain of matrix modules on one chip select GPIO.
+// matrix_table[chain position] = module location (y/8 * modules of x + x/8)
+// chain position 0 is the first 2 bytes of the SPI line. (NULL : sequential)
+//------------------------------------------------------------------------------
+struct matrix_chain {
+    int cs_pin;
+    int num_of_module;
+    const unsigned short *matrix_table;
+};
+
 //------------------------------------------------------------------------------
-class lib_matrix
+// SPI transport. (NULL : ESP8266 H/W SPI, async update and refresh timer)
+// ex) max7219_emu : host MAX7219 chain emulator.
+//------------------------------------------------------------------------------
+class matrix_spi
 {
+public:
+    virtual ~matrix_spi () {};
+    virtual void begin    (unsigned long spi_freq) {};
+    virtual void cs_init  (int cs_pin) {};
+    virtual void cs_write (int cs_pin, int level) = 0;
+    virtual void write    (const unsigned char *p_buf, int bytes) = 0;
+};
+
+// async line transaction (chain, offset in tx buffer, bytes)
+struct matrix_tx {
+    unsigned short  chain;
+    unsigned short  bytes;
+    unsigned int    offset;
+};
+// lib_matrix buffers (given by lib_matrix_t)
+struct matrix_mem {
+    unsigned short  *p_matrix_table;
+    int             *p_chain_cs, *p_chain_start;
+    unsigned char   *p_spi_buffer, *p_tx_buffer, *p_cmd_buffer;
+    struct matrix_tx *p_tx_list;
+    unsigned char   *p_fb, *p_fb_front, *p_fb_sent;
+};
+
+//------------------------------------------------------------------------------
+class lib_matrix : public lib_display
+{
+protected:
+    // Mattrix Frame buffer (draw buffer)
+    unsigned char   *_p_fb;
+    int _fb_size;
+
+    // buffers from lib_matrix_t (module map already in p_mem->p_matrix_table)
+    lib_matrix (const int x_bits, const int y_bits,
+                const struct matrix_chain *chains, int num_of_chain,
+                unsigned long spi_freq, bool hw_cs,
+                matrix_spi *p_spi, const struct matrix_mem *p_mem);
+
 private:
     // x=8Dots, y=8Dots, total=64Dots
     const unsigned char _DotsOfOneModule = 64;
@@ -51,39 +139,225 @@ private:
 
     // Matrix dots
     int _x_dots, _y_dots;
-    // Matrix control table
-    unsigned char   *_p_matrix_table;
-    // Mattrix Frame buffer
-    unsigned char   *_p_fb;
-    int _fb_size;
+    // Matrix control table (all chains, DRAM)
+    unsigned short  *_p_matrix_table;
+    // chain info
+    int _num_of_chain;
+    int *_p_chain_cs;
+    int *_p_chain_start;
+    // buffers allocated by new[]
+    bool _own_mem;
+    // display buffer for present() / refresh timer
+    unsigned char   *_p_fb_front;
+    volatile bool   _swap_pending;
+    volatile unsigned long _refresh_us;
+    unsigned long   _frame_start_us, _frame_us;
+
+    // grayscale planes [plane][module][line] : draw, front(shown), next(presented)
+    int             _gray_planes, _gray_plane;
+    unsigned char   *_p_gray, *_p_gray_front, *_p_gray_next;
+
+    // module orientation and oriented module images (NULL : not used)
+    unsigned char   *_p_orient;
+    unsigned char   *_p_fb_wire;
 
-    // SPI buffer : Send to Matrix(MAX7219)
+    // Last data sent to matrix (dirty row check)
+    unsigned char   *_p_fb_sent;
+    bool _fb_sent_valid;
+    // SPI send bytes counter (for measure)
+    volatile unsigned long _tx_bytes;
+
+    // SPI buffer : Send to Matrix(MAX7219) (longest chain)
     unsigned char   *_p_spi_buffer;
     int _spi_send_bytes;
 
+    // chip select (H/W CS or GPIO CS)
+    bool _hw_cs;
+    // SPI transport (NULL : H/W SPI)
+    matrix_spi *_p_spi;
+
+    // async update : latched line transaction buffer (command + 8 lines)
+    unsigned char   *_p_tx_buffer;
+    struct matrix_tx *_p_tx_list;
+    // register command line (sent by the refresh timer)
+    unsigned char   *_p_cmd_buffer;
+    volatile bool   _cmd_pending;
+
+    // module intensity [current, fade start, fade target] (allocated on first use)
+    unsigned char   _brightness;
+    unsigned char   *_p_intensity, *_p_fade_from, *_p_fade_to;
+    unsigned long   _fade_start_ms, _fade_ms;
+    bool            _fading;
+    volatile int    _tx_lines, _tx_line, _tx_pos;
+    volatile bool   _tx_busy;
+    unsigned long   _tx_ticks_per_byte;
+    matrix_cb_t     _tx_done_cb;
+    void            *_tx_done_arg;
+
+    void _setup (int x_dots, int y_dots, const struct matrix_chain *chains,
+                int num_of_chain, const struct matrix_mem *p_mem);
     void _init (unsigned long spi_freq , bool hw_cs);
-    void _send_to_matrix ();
+    void _clear ();
+    void _release ();
+    void _send_cmd (unsigned char reg, unsigned char data,
+                    const unsigned char *p_data = NULL);
+    bool _alloc_intensity ();
+    // the update path (timer1 ISR) reads DRAM tables only, no flash / virtual
+    bool _make_line (int line, int chain, const unsigned char *p_src,
+                    unsigned char *p_buf);
+    void _add_tx (int chain, int offset);
+    const unsigned char *_apply_orient (const unsigned char *p_src);
+    int  _stage_lines (const unsigned char *p_src);
+    void _update (const unsigned char *p_src);
+    void _copy_line (int dst_y, int src_y);
+    void _set_line (int y, const unsigned char *p_line);
+    void _cs_write (int chain, int level);
+    void _wait_tx_done ();
+    void _send_to_matrix (int chain, const unsigned char *p_buf, int bytes);
+    void _tx_start ();
+    void _tx_service ();
+    void _frame_start ();
+    void _frame_next ();
+    static void _tx_isr ();
+    static lib_matrix *_p_tx_owner;
 
 public:
 
+    // begin() must be called before use.
     lib_matrix (/* args */);
     // SPI Default freq 1Mhz
+    // hw_cs = false or chain > SPI_FIFO_BYTES : cs_pin is controlled by GPIO.
     lib_matrix (const int x_bits, const int y_bits, const unsigned char *matrix_table,
-                unsigned long spi_freq = 1000000, bool hw_cs = true);
+                unsigned long spi_freq = 1000000, bool hw_cs = true,
+                int cs_pin = SS, matrix_spi *p_spi = NULL);
+    // multi chain : each chain has own CS GPIO, only the changed chains are sent.
+    lib_matrix (const int x_bits, const int y_bits,
+                const struct matrix_chain *chains, int num_of_chain,
+                unsigned long spi_freq = 1000000, matrix_spi *p_spi = NULL);
     ~lib_matrix ();
 
+    // (re)setup of the matrix, same args as the constructors.
+    void begin (const int x_bits, const int y_bits, const unsigned char *matrix_table,
+                unsigned long spi_freq = 1000000, bool hw_cs = true,
+                int cs_pin = SS, matrix_spi *p_spi = NULL);
+    void begin (const int x_bits, const int y_bits,
+                const struct matrix_chain *chains, int num_of_chain,
+                unsigned long spi_freq = 1000000, matrix_spi *p_spi = NULL);
+    // matrix_layout : layout file compiled to tables. (matrix_layout.h)
+    void begin (const matrix_layout &layout, matrix_spi *p_spi = NULL);
+
+    // send only changed digit rows to matrix
     void update ();
+    // send all digit rows to matrix (ignore dirty check)
+    void refresh () {
+        _fb_sent_valid = false;     update();
+    }
     void brightness (unsigned char brightness);
 
+    // per module intensity (0x0 ~ 0xF), p_intensity[location of module].
+    // all chains are written in one command transaction, display data untouched.
+    void set_intensity (const unsigned char *p_intensity);
+    void set_intensity (int location_of_module, unsigned char intensity);
+    unsigned char get_intensity (int location_of_module);
+    // intensity ramp from the current levels to target over fade_ms.
+    // fade_loop() must be called from loop(), only changed levels are sent.
+    void fade_to (const unsigned char *p_intensity, unsigned long fade_ms);
+    void fade_to (unsigned char intensity, unsigned long fade_ms);
+    bool fade_loop ();
+    bool is_fading () {
+        return  _fading;
+    }
+
+    // grayscale : planes(1 ~ 4) bit-planes shown for (unit_us << plane) each.
+    // unit_us = 0 : one full frame push time. (timer1, H/W SPI only)
+    // 3 ~ 4 planes flicker on long chains, 2 planes (4 levels) is recommended.
+    bool start_gray (int planes = 2, unsigned long unit_us = 0);
+    void stop_gray ();
+    void set_gray (int x, int y, unsigned char level);
+    unsigned char get_gray (int x, int y);
+    // lib_fb luminance (1, 16, 24, 32 bpp) to gray level
+    void blit_gray (const lib_fb &fb, int x_off, int y_off);
+    void present_gray ();
+
+    // full frame push time (us).
+    // get_push_us : estimate from the SPI clock and FIFO reloads (no ISR latency)
+    // measure_push_us : timed forced update on the board (refresh timer stopped,
+    //                   otherwise the estimate is returned)
+    unsigned long get_push_us ();
+    unsigned long measure_push_us ();
+    // max full frame pushes per second, ESTIMATE from get_push_us().
+    // not a board measurement : 1000000 / measure_push_us() on the target.
+    unsigned long get_max_refresh_rate () {
+        return  1000000UL / get_push_us ();
+    }
+
+    // non-blocking update (timer1 interrupt feeds the SPI FIFO)
+    // timer1 is shared with analogWrite/tone/Servo, do not use them together.
+    void update_async ();
+    bool is_busy () {
+        return  _tx_busy;
+    }
+    void set_update_callback (matrix_cb_t cb, void *arg = NULL) {
+        _tx_done_cb = cb;   _tx_done_arg = arg;
+    }
+
+    // double buffer : draw buffer <-> display buffer
+    // p_region : not used, only the changed digit lines are sent.
+    void swap ();
+    void present (const struct disp_region *p_region = NULL);
+    // constant rate refresh of the display buffer (timer1 interrupt)
+    void start_refresh (unsigned int fps);
+    void stop_refresh ();
+
+    unsigned long get_tx_bytes () {
+        return  _tx_bytes;
+    }
+    void clear_tx_bytes () {
+        _tx_bytes = 0;
+    }
+
     void fill (unsigned char fill) {
         memset (_p_fb, fill, _fb_size);
     }
     void set_bit (int x, int y, bool onoff);
     bool get_bit (int x, int y);
 
+    // copy framebuffer(x_off, y_off) ~ (x_off + x_dots, y_off + y_dots) to matrix
+    // x_wrap : x wraps around the fb width. (ring framebuffer)
+    void blit (const lib_fb &fb, int x_off, int y_off, bool x_wrap = false);
+    // modules of the region only (region is aligned to the module column)
+    void blit_region (const lib_fb &fb, int x_off, int y_off,
+                        const struct disp_region *p_region);
+    // x_dots columns of the column stream (lib_fb::draw_text_columns) to matrix.
+    // one 8 x 8 transpose per module. next frame : p_columns + n * column bytes
+    // (or scroll_left (n, p_columns + x_dots * column bytes))
+    void blit_columns (const unsigned char *p_columns);
+
+    // lib_display (draw buffer : 8 x 8 modules, MSB first line byte)
+    int get_width  () const { return _x_dots; }
+    int get_height () const { return _y_dots; }
+    int get_format () const { return DISP_FMT_MODULE8_MSB; }
+    int get_x_align () const { return 8; }
+    unsigned char *get_buffer () { return _p_fb; }
+    void set_pixel (int x, int y, bool onoff) { set_bit (x, y, onoff); }
+
+    // scroll n dots with carry between modules, new data enters at the edge.
+    // columns : column-major, (y_dots + 7) / 8 bytes per column (LSB = top line)
+    // lines   : x_dots / 8 bytes per line (MSB = left dot)
+    // NULL    : blank columns / lines, n <= 0 : nothing is changed
+    void scroll_left  (int n, const unsigned char *p_new_columns = NULL);
+    void scroll_right (int n, const unsigned char *p_new_columns = NULL);
+    void scroll_up    (int n, const unsigned char *p_new_lines = NULL);
+    void scroll_down  (int n, const unsigned char *p_new_lines = NULL);
+
     void set_module_byte (int location_of_module, int line_of_module,
                         unsigned char byte);
     unsigned char get_module_byte (int location_of_module, int line_of_module);
+
+    // module orientation (rotated / mirrored module mount)
+    void set_orientation (int location_of_module, unsigned char orient);
+    void set_orientation (unsigned char orient);
+
     int num_of_module () {
         return  _num_of_module;
     }
@@ -95,6 +369,117 @@ public:
     }
 };
 
+//------------------------------------------------------------------------------
+// lib_matrix_t static buffers. MAP (PROGMEM or not) is copied once to the DRAM
+// matrix_table : the update path runs in the timer1 ISR, which must not read
+// flash (flash cache is off during OTA / LittleFS writes).
+//------------------------------------------------------------------------------
+template <int MODULES, const unsigned char *MAP>
+struct matrix_storage {
+    unsigned short  matrix_table[MODULES];
+    int             chain_cs[1], chain_start[2];
+    unsigned char   spi_buffer[MODULES * 2];
+    unsigned char   tx_buffer[MODULES * 2 * 9];
+    unsigned char   cmd_buffer[MODULES * 2];
+    struct matrix_tx tx_list[9];
+    unsigned char   fb[MODULES * 8], fb_front[MODULES * 8], fb_sent[MODULES * 8];
+
+    struct matrix_chain chain;
+    struct matrix_mem   mem;
+
+    matrix_storage () {
+        for (int i = 0; i < MODULES; i++)
+            matrix_table[i] = (MAP != NULL) ? pgm_read_byte (&MAP[i]) : i;
+
+        mem.p_matrix_table  = matrix_table;
+        mem.p_chain_cs      = chain_cs;
+        mem.p_chain_start   = chain_start;
+        mem.p_spi_buffer    = spi_buffer;
+        mem.p_tx_buffer     = tx_buffer;
+        mem.p_cmd_buffer    = cmd_buffer;
+        mem.p_tx_list       = tx_list;
+        mem.p_fb            = fb;
+        mem.p_fb_front      = fb_front;
+        mem.p_fb_sent       = fb_sent;
+    }
+    // chain.matrix_table == mem.p_matrix_table : lib_matrix uses it in place
+    const struct matrix_chain *get_chain (int cs_pin) {
+        chain.cs_pin        = cs_pin;
+        chain.num_of_module = MODULES;
+        chain.matrix_table  = matrix_table;
+        return  &chain;
+    }
+};
+
+//------------------------------------------------------------------------------
+// Compile-time geometry matrix (single chain).
+// X_DOTS, Y_DOTS are constants : pixel index math folds to shift/mask and all
+// buffers are statically sized members. (no new[])
+// set_bit / get_bit / fill / set_module_byte hide the lib_matrix functions,
+// only calls on the lib_matrix_t object use the constant math. calls through
+// lib_matrix& use the runtime math, except set_pixel (virtual, lib_display
+// and lib_matrix::blit of non 1bpp fb). update / line staging is lib_matrix's.
+//
+//  const unsigned char MatrixMap[] PROGMEM = { ... };
+//  lib_matrix_t <128, 16, MatrixMap> matrix (2000000, true);
+//------------------------------------------------------------------------------
+template <int X_DOTS, int Y_DOTS, const unsigned char *MAP = nullptr>
+class lib_matrix_t : private matrix_storage<(X_DOTS * Y_DOTS) / 64, MAP>,
+                    public lib_matrix
+{
+private:
+    typedef matrix_storage<(X_DOTS * Y_DOTS) / 64, MAP> storage;
+    static const unsigned int MODULES  = (X_DOTS * Y_DOTS) / 64;
+    static const unsigned int MODULE_X = X_DOTS / 8;
+
+    static_assert (((X_DOTS % 8) == 0) && ((Y_DOTS % 8) == 0),
+                    "matrix dots must be a multiple of 8");
+
+    static inline unsigned int _offset (unsigned int x, unsigned int y) {
+        // (module location * 8) + line of module
+        return  (((y / 8) * MODULE_X + (x / 8)) * 8) + (y % 8);
+    }
+
+public:
+    lib_matrix_t (unsigned long spi_freq = 1000000, bool hw_cs = true,
+                int cs_pin = SS, matrix_spi *p_spi = NULL) :
+        storage (),
+        lib_matrix (X_DOTS, Y_DOTS, storage::get_chain (cs_pin), 1,
+                    spi_freq, hw_cs, p_spi, &(storage::mem)) {};
+
+    inline void set_bit (int x, int y, bool onoff) {
+        unsigned char mask = 0x80 >> ((unsigned int)x % 8);
+
+        if (onoff)  _p_fb[_offset (x, y)] |=  mask;
+        else        _p_fb[_offset (x, y)] &= ~mask;
+    }
+    inline bool get_bit (int x, int y) {
+        return  (_p_fb[_offset (x, y)] & (0x80 >> ((unsigned int)x % 8))) ? true : false;
+    }
+    void set_pixel (int x, int y, bool onoff) {
+        set_bit (x, y, onoff);
+    }
+    inline void set_module_byte (int location_of_module, int line_of_module,
+                                unsigned char byte) {
+        _p_fb[(location_of_module * 8) + line_of_module] = byte;
+    }
+    inline unsigned char get_module_byte (int location_of_module, int line_of_module) {
+        return  _p_fb[(location_of_module * 8) + line_of_module];
+    }
+    void fill (unsigned char fill) {
+        memset (_p_fb, fill, X_DOTS * Y_DOTS / 8);
+    }
+    int num_of_module () {
+        return  MODULES;
+    }
+    int get_x_dots() {
+        return  X_DOTS;
+    }
+    int get_y_dots() {
+        return  Y_DOTS;
+    }
+};
+
 //------------------------------------------------------------------------------
 #endif  // __LIB_MATRIX_H__
 //------------------------------------------------------------------------------
@@ -0,0 +1,366 @@
+//------------------------------------------------------------------------------
+/**
+ * @file matrix_layout.cpp
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Matrix panel layout file. (lib_matrix chain / module map tables)
+ * @version 0.1
+ * @date 2023-06-20
+ *
+ * @copyright Copyright (c) 2022
+ *
+*/
+//------------------------------------------------------------------------------
+#if defined(ARDUINO)
+#include <LittleFS.h>
+#else
+#include <stdio.h>
+#endif
+#include <stdlib.h>
+#include "matrix_layout.h"
+
+//------------------------------------------------------------------------------
+// Next word of the line (space separated, '#' : comment). NULL : end of line
+//
+static char *_next_word (char **pp_line)
+{
+    char *p = *pp_line, *p_word;
+
+    while ((*p == ' ') || (*p == '\t') || (*p == '\r'))
+        p++;
+    if (!*p || (*p == '#'))
+        return  NULL;
+
+    p_word = p;
+    while (*p && (*p != ' ') && (*p != '\t') && (*p != '\r') && (*p != '#'))
+        p++;
+    if (*p == '#')
+        *p = 0;
+    else if (*p)
+        *p++ = 0;
+    *pp_line = p;
+    return  p_word;
+}
+
+//------------------------------------------------------------------------------
+static bool _to_int (const char *p_word, int *p_value)
+{
+    char *p_end;
+
+    if (!p_word)
+        return  false;
+    *p_value = strtol (p_word, &p_end, 0);
+    return  (p_end != p_word) && !*p_end;
+}
+
+//------------------------------------------------------------------------------
+matrix_layout::matrix_layout ()
+{
+    _p_table = NULL;    _p_orient = NULL;
+    _free ();
+}
+
+//------------------------------------------------------------------------------
+matrix_layout::~matrix_layout ()
+{
+    _free ();
+}
+
+//------------------------------------------------------------------------------
+void matrix_layout::_free ()
+{
+    if (_p_table)
+        delete[]    _p_table;
+    if (_p_orient)
+        delete[]    _p_orient;
+    _p_table = NULL;    _p_orient = NULL;
+
+    _x_dots = _y_dots = _num_of_module = 0;
+    _spi_freq = 1000000;    _brightness = 0;
+    _num_of_chain = 0;      _error_line = 0;
+    memset (_chain, 0, sizeof(_chain));
+    memset (_map_cnt, 0, sizeof(_map_cnt));
+}
+
+//------------------------------------------------------------------------------
+bool matrix_layout::_alloc ()
+{
+    if ((_x_dots <= 0) || (_y_dots <= 0) || (_x_dots % 8) || (_y_dots % 8) || _p_table)
+        return  false;
+
+    _num_of_module = (_x_dots / 8) * (_y_dots / 8);
+    _p_table  = new unsigned short [_num_of_module];
+    _p_orient = new unsigned char  [_num_of_module];
+    if (!_p_table || !_p_orient)
+        return  false;
+    memset (_p_orient, MATRIX_ROT_0, _num_of_module);
+    return  true;
+}
+
+//------------------------------------------------------------------------------
+// map word : N (module location), N-M (range), col,row (module position)
+//
+bool matrix_layout::_add_map (const char *p_word)
+{
+    int c = _num_of_chain - 1, from, to, step;
+    const char *p_sep;
+    char num[12];
+
+    if ((c < 0) || (strlen (p_word) >= sizeof(num)))
+        return  false;
+
+    strcpy (num, p_word);
+    if ((p_sep = strchr (p_word, ',')) != NULL) {
+        int col, row;
+
+        num[p_sep - p_word] = 0;
+        if (!_to_int (num, &col) || !_to_int (p_sep + 1, &row) ||
+            (col < 0) || (col >= _x_dots / 8) || (row < 0) || (row >= _y_dots / 8))
+            return  false;
+        from = to = row * (_x_dots / 8) + col;
+    } else if ((p_sep = strchr (p_word + 1, '-')) != NULL) {
+        num[p_sep - p_word] = 0;
+        if (!_to_int (num, &from) || !_to_int (p_sep + 1, &to))
+            return  false;
+    } else {
+        if (!_to_int (num, &from))
+            return  false;
+        to = from;
+    }
+
+    step = (to >= from) ? 1 : -1;
+    for (int location = from; ; location += step) {
+        int start = _chain[c].matrix_table - _p_table;
+
+        if ((location < 0) || (location >= _num_of_module) ||
+            (_map_cnt[c] >= _chain[c].num_of_module))
+            return  false;
+        _p_table[start + _map_cnt[c]++] = location;
+        if (location == to)
+            break;
+    }
+    return  true;
+}
+
+//------------------------------------------------------------------------------
+// p_rot : 0, 90, 180, 270. p_args : mx (mirror x), my (mirror y)
+//
+bool matrix_layout::_set_orient (int location, const char *p_rot, char *p_args)
+{
+    unsigned char orient;
+    char *p_word;
+    int rot;
+
+    if (!_to_int (p_rot, &rot) || (rot % 90) || (rot < 0) || (rot > 270))
+        return  false;
+
+    orient = rot / 90;
+    while ((p_word = _next_word (&p_args)) != NULL) {
+        if      (!strcmp (p_word, "mx"))    orient |= MATRIX_MIRROR_X;
+        else if (!strcmp (p_word, "my"))    orient |= MATRIX_MIRROR_Y;
+        else
+            return  false;
+    }
+
+    if (location < 0) {
+        memset (_p_orient, orient, _num_of_module);
+        return  true;
+    }
+    if (location >= _num_of_module)
+        return  false;
+    _p_orient[location] = orient;
+    return  true;
+}
+
+//------------------------------------------------------------------------------
+bool matrix_layout::_parse_line (char *p_line)
+{
+    char *p_key = _next_word (&p_line), *p_word;
+    int value, value2;
+
+    /* empty line or comment */
+    if (!p_key)
+        return  true;
+
+    if (!strcmp (p_key, "size")) {
+        if (!_to_int (_next_word (&p_line), &_x_dots) ||
+            !_to_int (_next_word (&p_line), &_y_dots))
+            return  false;
+        return  _alloc ();
+    }
+    if (!strcmp (p_key, "spi")) {
+        if (!_to_int (_next_word (&p_line), &value) || (value <= 0))
+            return  false;
+        _spi_freq = value;
+        return  true;
+    }
+    if (!strcmp (p_key, "brightness")) {
+        if (!_to_int (_next_word (&p_line), &value) || (value < 1) || (value > 15))
+            return  false;
+        _brightness = value;
+        return  true;
+    }
+
+    /* size must be set before the module tables */
+    if (!_p_table)
+        return  false;
+
+    if (!strcmp (p_key, "chain")) {
+        int start = 0;
+
+        if (!_to_int (_next_word (&p_line), &value) ||
+            !_to_int (_next_word (&p_line), &value2) ||
+            (value2 <= 0) || (_num_of_chain >= MATRIX_LAYOUT_CHAINS))
+            return  false;
+        if (_num_of_chain) {
+            struct matrix_chain *p_prev = &_chain[_num_of_chain - 1];
+            start = (p_prev->matrix_table - _p_table) + p_prev->num_of_module;
+        }
+        if (start + value2 > _num_of_module)
+            return  false;
+        _chain[_num_of_chain].cs_pin        = value;
+        _chain[_num_of_chain].num_of_module = value2;
+        _chain[_num_of_chain].matrix_table  = &_p_table[start];
+        _num_of_chain++;
+        return  true;
+    }
+    if (!strcmp (p_key, "map")) {
+        while ((p_word = _next_word (&p_line)) != NULL) {
+            if (!_add_map (p_word))
+                return  false;
+        }
+        return  true;
+    }
+    if (!strcmp (p_key, "orient")) {
+        if (!(p_word = _next_word (&p_line)))
+            return  false;
+        if (!strcmp (p_word, "all"))
+            value = -1;
+        else if (!_to_int (p_word, &value) || (value < 0))
+            return  false;
+        p_word = _next_word (&p_line);
+        return  _set_orient (value, p_word, p_line);
+    }
+    /* unknown keyword */
+    return  false;
+}
+
+//------------------------------------------------------------------------------
+// Check chain map and fill the sequential chains.
+// all modules must be used once.
+//
+bool matrix_layout::_compile ()
+{
+    unsigned char *p_used;
+    int total = 0;
+    bool ok = true;
+
+    if (!_p_table || !_num_of_chain)
+        return  false;
+
+    p_used = new unsigned char [_num_of_module];
+    if (!p_used)
+        return  false;
+    memset (p_used, 0, _num_of_module);
+
+    for (int c = 0; c < _num_of_chain; c++) {
+        unsigned short *p_table = _p_table + (_chain[c].matrix_table - _p_table);
+
+        if (!_map_cnt[c]) {
+            for (int i = 0; i < _chain[c].num_of_module; i++)
+                p_table[i] = total + i;
+        } else if (_map_cnt[c] != _chain[c].num_of_module) {
+            ok = false;
+        }
+        for (int i = 0; ok && (i < _chain[c].num_of_module); i++) {
+            if (p_used[p_table[i]]++)
+                ok = false;
+        }
+        total += _chain[c].num_of_module;
+    }
+    delete[]    p_used;
+
+    return  ok && (total == _num_of_module);
+}
+
+//------------------------------------------------------------------------------
+bool matrix_layout::parse (const char *p_text)
+{
+    char *p_buf, *p_line;
+    int line = 0;
+    bool ok = true;
+
+    _free ();
+    p_buf = new char [strlen (p_text) + 1];
+    if (!p_buf)
+        return  false;
+    strcpy (p_buf, p_text);
+
+    for (p_line = p_buf; ok && p_line; line++) {
+        char *p_next = strchr (p_line, '\n');
+
+        if (p_next)
+            *p_next++ = 0;
+        if (!_parse_line (p_line)) {
+            _error_line = line + 1;
+            ok = false;
+        }
+        p_line = p_next;
+    }
+    delete[]    p_buf;
+
+    if (ok && !_compile ()) {
+        /* end of file */
+        _error_line = line;
+        ok = false;
+    }
+    if (!ok) {
+        int error_line = _error_line;
+
+        _free ();
+        _error_line = error_line;
+    }
+    return  ok;
+}
+
+//------------------------------------------------------------------------------
+bool matrix_layout::load (const char *path)
+{
+    char *p_text;
+    bool ok;
+    int size;
+
+#if defined(ARDUINO)
+    File file;
+
+    if (!LittleFS.begin ())
+        return  false;
+    if (!(file = LittleFS.open (path, "r")))
+        return  false;
+    size   = file.size ();
+    p_text = new char [size + 1];
+    if (p_text)
+        p_text[file.readBytes (p_text, size)] = 0;
+    file.close ();
+#else
+    FILE *fp = fopen (path, "r");
+
+    if (!fp)
+        return  false;
+    fseek (fp, 0, SEEK_END);
+    size = ftell (fp);
+    fseek (fp, 0, SEEK_SET);
+    p_text = new char [size + 1];
+    if (p_text)
+        p_text[fread (p_text, 1, size, fp)] = 0;
+    fclose (fp);
+#endif
+    if (!p_text)
+        return  false;
+
+    ok = parse (p_text);
+    delete[]    p_text;
+    return  ok;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------------
+/**
+ * @file matrix_layout.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief Matrix panel layout file. (lib_matrix chain / module map tables)
+ * @version 0.1
+ * @date 2023-06-20
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * The layout text is compiled once into the same flat tables as the hardcoded
+ * MatrixMap, so one firmware serves every sign size.
+ *
+ *  # data/layout.txt (LittleFS)
+ *  size 128 16                 # x dots, y dots (multiple of 8)
+ *  spi 2000000                 # SPI clock (Hz)
+ *  brightness 3                # 1 ~ 15
+ *  chain 15 32                 # cs pin, num of module
+ *  map 0-7 16-23 8-15 24-31    # module of each chain position (N, N-M, col,row)
+ *  orient all 0                # module | all, 0/90/180/270 [mx] [my]
+ *
+ *  map lines are added to the last chain. chain without map : sequential.
+ *
+ *  matrix_layout layout;
+ *  if (layout.load ("/layout.txt"))
+ *      matrix.begin (layout);
+*/
+//------------------------------------------------------------------------------
+#ifndef __MATRIX_LAYOUT_H__
+#define __MATRIX_LAYOUT_H__
+
+#include "lib_matrix.h"
+
+//------------------------------------------------------------------------------
+#define MATRIX_LAYOUT_CHAINS    8
+
+//------------------------------------------------------------------------------
+class matrix_layout
+{
+private:
+    int             _x_dots, _y_dots, _num_of_module;
+    unsigned long   _spi_freq;
+    unsigned char   _brightness;
+
+    int             _num_of_chain;
+    struct matrix_chain _chain[MATRIX_LAYOUT_CHAINS];
+    // _p_table[chain start + chain position] = module location
+    unsigned short  *_p_table;
+    // map entries of each chain (0 : sequential)
+    int             _map_cnt[MATRIX_LAYOUT_CHAINS];
+    unsigned char   *_p_orient;
+
+    // error line of the layout text (0 = no error)
+    int             _error_line;
+
+    void _free ();
+    bool _alloc ();
+    bool _parse_line (char *p_line);
+    bool _add_map (const char *p_word);
+    bool _set_orient (int location, const char *p_rot, char *p_args);
+    bool _compile ();
+
+public:
+    matrix_layout ();
+    ~matrix_layout ();
+
+    // layout text -> tables. return false on error (get_error_line)
+    bool parse (const char *p_text);
+    // LittleFS file (host : stdio file)
+    bool load  (const char *path);
+
+    int get_error_line () const { return _error_line; }
+
+    int get_x_dots () const { return _x_dots; }
+    int get_y_dots () const { return _y_dots; }
+    unsigned long get_spi_freq () const { return _spi_freq; }
+    // 0 : not set
+    unsigned char get_brightness () const { return _brightness; }
+    int get_num_of_chain () const { return _num_of_chain; }
+    const struct matrix_chain *get_chains () const { return _chain; }
+    unsigned char get_orientation (int location_of_module) const {
+        return  (_p_orient && (location_of_module >= 0) &&
+                (location_of_module < _num_of_module)) ?
+                    _p_orient[location_of_module] : MATRIX_ROT_0;
+    }
+};
+
+//------------------------------------------------------------------------------
+#endif  // __MATRIX_LAYOUT_H__
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
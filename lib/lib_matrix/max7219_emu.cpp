@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------------
+/**
+ * @file max7219_emu.cpp
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief MAX7219 daisy chain emulator. (lib_matrix matrix_spi transport)
+ * @version 0.1
+ * @date 2023-06-12
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Data sheet
+ * https://www.analog.com/media/en/technical-documentation/data-sheets/max7219-max7221.pdf
+*/
+//------------------------------------------------------------------------------
+#include "max7219_emu.h"
+
+//------------------------------------------------------------------------------
+// Code B font (D7 = DP, D6 ~ D0 = segment A ~ G)
+// 0 ~ 9, '-', 'E', 'H', 'L', 'P', blank
+//------------------------------------------------------------------------------
+static const unsigned char CodeB[16] = {
+    0x7E, 0x30, 0x6D, 0x79, 0x33, 0x5B, 0x5F, 0x70,
+    0x7F, 0x7B, 0x01, 0x4F, 0x37, 0x0E, 0x67, 0x00,
+};
+
+//------------------------------------------------------------------------------
+struct max7219_chain *max7219_emu::_find_chain (int cs_pin)
+{
+    for (int c = 0; c < _num_of_chain; c++) {
+        if (_chain[c].cs_pin == cs_pin)
+            return  &_chain[c];
+    }
+    return  NULL;
+}
+
+//------------------------------------------------------------------------------
+struct max7219_reg *max7219_emu::_find_module (int cs_pin, int module)
+{
+    struct max7219_chain *p_chain = _find_chain (cs_pin);
+
+    if (!p_chain || (module < 0) || (module >= p_chain->num_of_module))
+        return  NULL;
+
+    return  &p_chain->p_module[p_chain->num_of_module - 1 - module];
+}
+
+//------------------------------------------------------------------------------
+bool max7219_emu::add_chain (int cs_pin, int num_of_module)
+{
+    struct max7219_chain *p_chain;
+
+    if ((_num_of_chain >= MAX7219_EMU_CHAINS) || _find_chain (cs_pin))
+        return  false;
+
+    p_chain = &_chain[_num_of_chain++];
+    p_chain->cs_pin        = cs_pin;
+    p_chain->num_of_module = num_of_module;
+    p_chain->selected      = false;
+    p_chain->p_module      = new struct max7219_reg [num_of_module];
+
+    /* power-up : shutdown mode, all registers cleared */
+    memset (p_chain->p_module, 0, sizeof(struct max7219_reg) * num_of_module);
+    return  true;
+}
+
+//------------------------------------------------------------------------------
+// Data is latched into the register on the CS rising edge.
+//
+void max7219_emu::_latch (struct max7219_reg *p_reg)
+{
+    unsigned char addr = (p_reg->shift >> 8) & 0x0F, data = p_reg->shift & 0xFF;
+
+    switch (addr) {
+        case    0x00:   /* No-Op */
+        break;
+        case    0x01:   case    0x02:   case    0x03:   case    0x04:
+        case    0x05:   case    0x06:   case    0x07:   case    0x08:
+            p_reg->digit[addr - 1] = data;
+        break;
+        case    0x09:   p_reg->decode     = data;           break;
+        case    0x0a:   p_reg->intensity  = data & 0x0F;    break;
+        case    0x0b:   p_reg->scan_limit = data & 0x07;    break;
+        case    0x0c:   p_reg->shutdown   = data & 0x01;    break;
+        case    0x0f:   p_reg->test       = data & 0x01;    break;
+        default :
+        break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void max7219_emu::cs_write (int cs_pin, int level)
+{
+    struct max7219_chain *p_chain = _find_chain (cs_pin);
+
+    if (!p_chain)
+        return;
+
+    if (!level) {
+        p_chain->selected = true;
+        return;
+    }
+    if (p_chain->selected) {
+        for (int i = 0; i < p_chain->num_of_module; i++)
+            _latch (&p_chain->p_module[i]);
+        p_chain->selected = false;
+        _tx_latch++;
+    }
+}
+
+//------------------------------------------------------------------------------
+// DIN -> module[0] -> DOUT -> module[1] ... (MSB first, 8 bits at a time)
+//
+void max7219_emu::write (const unsigned char *p_buf, int bytes)
+{
+    for (int c = 0; c < _num_of_chain; c++) {
+        struct max7219_chain *p_chain = &_chain[c];
+
+        if (!p_chain->selected)
+            continue;
+
+        for (int i = 0; i < bytes; i++) {
+            unsigned char din = p_buf[i], dout;
+
+            for (int j = 0; j < p_chain->num_of_module; j++) {
+                dout = p_chain->p_module[j].shift >> 8;
+                p_chain->p_module[j].shift = (p_chain->p_module[j].shift << 8) | din;
+                din = dout;
+            }
+        }
+    }
+    _tx_bytes += bytes;
+}
+
+//------------------------------------------------------------------------------
+unsigned char max7219_emu::get_led_line (int cs_pin, int module, int line)
+{
+    struct max7219_reg *p_reg = _find_module (cs_pin, module);
+    unsigned char data;
+
+    if (!p_reg || (line < 0) || (line > 7))
+        return  0;
+
+    if (p_reg->test)
+        return  0xFF;
+    if (!p_reg->shutdown || (line > p_reg->scan_limit))
+        return  0;
+
+    data = p_reg->digit[line];
+    if (p_reg->decode & (1 << line))
+        data = (data & 0x80) | CodeB[data & 0x0F];
+
+    return  data;
+}
+
+//------------------------------------------------------------------------------
+max7219_emu::max7219_emu ()
+{
+    _num_of_chain = 0;
+    _spi_freq = 0;
+    clear_counter ();
+}
+
+//------------------------------------------------------------------------------
+max7219_emu::~max7219_emu ()
+{
+    for (int c = 0; c < _num_of_chain; c++)
+        delete[]    _chain[c].p_module;
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
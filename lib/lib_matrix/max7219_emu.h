@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+/**
+ * @file max7219_emu.h
+ * @author charles-park (charles.park@hardkernel.com)
+ * @brief MAX7219 daisy chain emulator. (lib_matrix matrix_spi transport)
+ * @version 0.1
+ * @date 2023-06-12
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Data sheet
+ * https://www.analog.com/media/en/technical-documentation/data-sheets/max7219-max7221.pdf
+ *
+ * Used to run lib_matrix off-device (host build).
+ * The emulator models the 16 bit shift register of each module(DIN -> DOUT),
+ * latch on CS rising edge and the No-Op, Digit 0~7, Decode mode, Intensity,
+ * Scan limit, Shutdown and Display test registers.
+ *
+ *  max7219_emu emu;
+ *  emu.add_chain (SS, 32);
+ *  lib_matrix  matrix (128, 16, MatrixMap, 2000000, false, SS, &emu);
+ *  ...
+ *  emu.get_led_line (SS, 0, 0);    // first module of the SPI line, digit 0
+*/
+//------------------------------------------------------------------------------
+#ifndef __MAX7219_EMU_H__
+#define __MAX7219_EMU_H__
+
+#include "lib_matrix.h"
+
+//------------------------------------------------------------------------------
+#define MAX7219_EMU_CHAINS  8
+
+//------------------------------------------------------------------------------
+struct max7219_reg {
+    // DIN -> DOUT shift register (D15 ~ D0)
+    unsigned short  shift;
+    unsigned char   digit[8];
+    unsigned char   decode;
+    unsigned char   intensity;
+    unsigned char   scan_limit;
+    // shutdown register D0 (0 = shutdown mode, 1 = normal operation)
+    unsigned char   shutdown;
+    unsigned char   test;
+};
+
+struct max7219_chain {
+    int cs_pin;
+    int num_of_module;
+    bool selected;
+    // p_module[0] : module connected to the MCU(DIN)
+    struct max7219_reg *p_module;
+};
+
+//------------------------------------------------------------------------------
+class max7219_emu : public matrix_spi
+{
+private:
+    struct max7219_chain _chain[MAX7219_EMU_CHAINS];
+    int _num_of_chain;
+
+    unsigned long _spi_freq;
+    // SPI bytes / latched transactions counter
+    unsigned long _tx_bytes, _tx_latch;
+
+    struct max7219_chain *_find_chain (int cs_pin);
+    struct max7219_reg   *_find_module (int cs_pin, int module);
+    void _latch (struct max7219_reg *p_reg);
+
+public:
+    max7219_emu ();
+    ~max7219_emu ();
+
+    bool add_chain (int cs_pin, int num_of_module);
+
+    // matrix_spi
+    void begin    (unsigned long spi_freq) { _spi_freq = spi_freq; };
+    void cs_write (int cs_pin, int level);
+    void write    (const unsigned char *p_buf, int bytes);
+
+    // module : SPI line order (0 = first 2 bytes of the line = end of the chain)
+    const struct max7219_reg *get_module (int cs_pin, int module) {
+        return  _find_module (cs_pin, module);
+    }
+    // LED state of the digit line (MSB = left dot)
+    unsigned char get_led_line (int cs_pin, int module, int line);
+
+    unsigned long get_tx_bytes () { return _tx_bytes; }
+    unsigned long get_tx_latch () { return _tx_latch; }
+    // SPI transfer time of the counted bytes
+    unsigned long get_tx_us () {
+        return  _spi_freq ? (unsigned long)((unsigned long long)_tx_bytes * 8 * 1000000 / _spi_freq) : 0;
+    }
+    void clear_counter () { _tx_bytes = 0;  _tx_latch = 0; }
+};
+
+//------------------------------------------------------------------------------
+#endif  // __MAX7219_EMU_H__
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
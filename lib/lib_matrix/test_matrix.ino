@@ -39,9 +39,30 @@ const unsigned char MatrixMap[] = {
 #define	X_DOTS	192
 #define	Y_DOTS	32
 
+// #define MULTI_CHAIN
+
+#if defined(MULTI_CHAIN)
+/* 192 x 32 : 3 chains of 32 modules (CS = D8, D2, D1) */
+const unsigned short MatrixChainMap[] = {
+     0,  1,  2,  3,  4,  5,  6,  7, 32, 33, 34, 35, 36, 37, 38, 39, 64, 65, 66, 67, 68, 69, 70, 71,
+     8,  9, 10, 11, 12, 13, 14, 15, 40, 41, 42, 43, 44, 45, 46, 47, 72, 73, 74, 75, 76, 77, 78, 79,
+    16, 17, 18, 19, 20, 21, 22, 23, 48, 49, 50, 51, 52, 53, 54, 55, 80, 81, 82, 83, 84, 85, 86, 87,
+    24, 25, 26, 27, 28, 29, 30, 31, 56, 57, 58, 59, 60, 61, 62, 63, 88, 89, 90, 91, 92, 93, 94, 95,
+};
+
+const struct matrix_chain MatrixChain[] = {
+    /* cs pin, num of module, chain map */
+    { 15, 32, &MatrixChainMap[ 0] },
+    {  4, 32, &MatrixChainMap[32] },
+    {  5, 32, &MatrixChainMap[64] },
+};
+
+lib_matrix  matrix (X_DOTS, Y_DOTS, MatrixChain, 3, 2000000);
+#else
 // Default SPI 1Mhz, HW cs = true
 //lib_matrix  matrix (X_DOTS, Y_DOTS, MatrixMap, 300000, true);
 lib_matrix  matrix (X_DOTS, Y_DOTS, MatrixMap, 2000000, true);
+#endif
 
 //------------------------------------------------------------------------------
 const unsigned char MatrixTestPattern[] = {
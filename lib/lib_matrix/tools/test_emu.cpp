@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------------
+// lib_matrix host test with the MAX7219 emulator (max7219_emu)
+//
+// update() / refresh() / brightness() / set_intensity() are sent to the
+// emulated chain, the LED image of each module is checked against _p_fb
+// through the module map and SPI bytes / latches per frame are printed.
+//   cd lib/lib_matrix
+//   g++ -O2 -I. -I../lib_fb tools/test_emu.cpp *.cpp ../lib_fb/*.cpp -o /tmp/test_emu
+//   /tmp/test_emu
+//------------------------------------------------------------------------------
+/* host only (not built into the firmware with the library sources) */
+#if !defined(ARDUINO)
+#include <lib_matrix.h>
+#include <max7219_emu.h>
+#include <lib_fb.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CS_PIN      15
+#define FRAMES      100
+
+// 128 x 16 billboard, upper / lower module lines are crossed on the chain
+const unsigned char MatrixMap[] PROGMEM = {
+     0,  1,  2,  3,  4,  5,  6,  7, 16, 17, 18, 19, 20, 21, 22, 23,
+     8,  9, 10, 11, 12, 13, 14, 15, 24, 25, 26, 27, 28, 29, 30, 31,
+};
+
+static int Errors = 0;
+
+//------------------------------------------------------------------------------
+// LED digit lines of the chain == draw buffer module lines (chain pos -> map)
+//
+static int check_image (lib_matrix &matrix, max7219_emu &emu, const char *name)
+{
+    int bad = 0;
+
+    for (int j = 0; j < matrix.num_of_module(); j++)
+        for (int line = 0; line < 8; line++)
+            if (emu.get_led_line (CS_PIN, j, line) !=
+                matrix.get_module_byte (pgm_read_byte (&MatrixMap[j]), line))
+                bad++;
+    if (bad)
+        printf ("FAIL %s : %d lines\n", name, bad);
+    Errors += bad;
+    return  bad;
+}
+
+//------------------------------------------------------------------------------
+static void check_reg (const char *name, int value, int expect)
+{
+    if (value != expect) {
+        printf ("FAIL %s : %d (expect %d)\n", name, value, expect);
+        Errors++;
+    }
+}
+
+//------------------------------------------------------------------------------
+static void print_frame (max7219_emu &emu, const char *name, int frames)
+{
+    printf ("%-16s : %5lu bytes, %3lu latches, %5lu us / frame\n", name,
+            emu.get_tx_bytes() / frames, emu.get_tx_latch() / frames,
+            emu.get_tx_us() / frames);
+    emu.clear_counter();
+}
+
+//------------------------------------------------------------------------------
+static void test_matrix (lib_matrix &matrix, max7219_emu &emu)
+{
+    lib_fb fb (400, 16, 1);
+    const struct max7219_reg *p_reg = emu.get_module (CS_PIN, 0);
+
+    /* _init : normal operation, no decode, 8 digit lines */
+    check_reg ("shutdown",   p_reg->shutdown,   1);
+    check_reg ("decode",     p_reg->decode,     0);
+    check_reg ("scan limit", p_reg->scan_limit, 7);
+
+    srand (2);
+    for (int y = 0; y < fb.get_height(); y++)
+        for (int x = 0; x < fb.get_width(); x++)
+            fb.put_pixel (x, y, (rand() % 3) == 0);
+
+    emu.clear_counter();
+    matrix.blit (fb, 0, 0);     matrix.refresh();
+    check_image (matrix, emu, "refresh");
+    print_frame (emu, "refresh", 1);
+
+    /* 1 dot scroll : only the changed digit lines */
+    for (int i = 1; i <= FRAMES; i++) {
+        matrix.blit (fb, i, 0);     matrix.update();
+        check_image (matrix, emu, "update");
+    }
+    print_frame (emu, "update (scroll)", FRAMES);
+
+    matrix.set_bit (3, 3, !matrix.get_bit (3, 3));
+    matrix.update();
+    check_image (matrix, emu, "one dot");
+    print_frame (emu, "update (1 dot)", 1);
+
+    matrix.update();
+    check_reg ("no change bytes", emu.get_tx_bytes(), 0);
+    emu.clear_counter();
+
+    /* register commands : display data untouched */
+    matrix.brightness (7);
+    for (int j = 0; j < matrix.num_of_module(); j++)
+        check_reg ("brightness", emu.get_module (CS_PIN, j)->intensity, 7);
+    check_image (matrix, emu, "brightness");
+    print_frame (emu, "brightness", 1);
+
+    /* module location 17 is the chain position 9 */
+    matrix.set_intensity (17, 3);
+    check_reg ("intensity", emu.get_module (CS_PIN, 9)->intensity, 3);
+    check_reg ("intensity", emu.get_module (CS_PIN, 8)->intensity, 7);
+    check_image (matrix, emu, "intensity");
+}
+
+//------------------------------------------------------------------------------
+int main ()
+{
+    {
+        max7219_emu emu;
+        emu.add_chain (CS_PIN, 32);
+        lib_matrix matrix (128, 16, MatrixMap, 2000000, true, CS_PIN, &emu);
+
+        printf ("lib_matrix (128 x 16, 2MHz)\n");
+        test_matrix (matrix, emu);
+    }
+    {
+        max7219_emu emu;
+        emu.add_chain (CS_PIN, 32);
+        lib_matrix_t <128, 16, MatrixMap> matrix (2000000, true, CS_PIN, &emu);
+
+        printf ("lib_matrix_t (128 x 16, 2MHz)\n");
+        test_matrix (matrix, emu);
+    }
+    printf ("%s (%d errors)\n", Errors ? "FAIL" : "PASS", Errors);
+    return  Errors ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+#endif  // !ARDUINO
@@ -97,18 +97,30 @@ lib_weather weather(&Client, "안양시 만안구 석수2동", "/wid/queryDFSRSS
     };
 #endif
 
-// Default SPI 1Mhz, HW cs = true
-lib_matrix  matrix (X_DOTS, Y_DOTS, MatrixMap, 2000000, true);
+// Panel layout file (LittleFS). If not found, the map above is used.
+#include <matrix_layout.h>
+
+#define MATRIX_LAYOUT_FILE  "/layout.txt"
+
+// setup by matrix_begin()
+lib_matrix matrix;
+
+// Matrix refresh rate (marquee scroll speed = 1 dot / frame)
+#define MATRIX_FPS  60
 
 //------------------------------------------------------------------------------
-// Text Draw framebuffer setup
-#include <lib_fb.h>
+// Text marquee (ring framebuffer of the matrix width, setup after matrix_begin)
+#include <lib_marquee.h>
 
-#define FB_W    1920
-#define FB_H    16
-#define FB_BPP  1
+lib_marquee *marquee;
+// text x of the shown view (transition start view)
+int marquee_pos = 0;
 
-lib_fb fb(FB_W, FB_H, FB_BPP);
+//------------------------------------------------------------------------------
+// Message change effect (old view -> new text at x = 0)
+#include <lib_transition.h>
+
+lib_transition *transition;
 
 //------------------------------------------------------------------------------
 // OTA update logic
@@ -143,15 +155,34 @@ struct tm *get_tm (NTPClient *pNTPClient)
 }
 
 //------------------------------------------------------------------------------
-void copy_fb_to_matrix (int x_offset, int y_offset)
+void matrix_begin ()
 {
-    matrix.fill(0x0);
-    for (int y = 0; y < matrix.get_y_dots(); y++) {
-        for (int x = 0; x < matrix.get_x_dots(); x++) {
-            matrix.set_bit (x, y, fb.get_pixel(x_offset + x, y_offset + y));
-        }
+    matrix_layout layout;
+
+    if (layout.load (MATRIX_LAYOUT_FILE)) {
+        Serial.printf ("Matrix layout : %s (%d x %d)\r\n", MATRIX_LAYOUT_FILE,
+                        layout.get_x_dots(), layout.get_y_dots());
+        matrix.begin (layout);
+        if (!layout.get_brightness())
+            matrix.brightness(3);
+        return;
     }
-    matrix.update();
+    if (layout.get_error_line())
+        Serial.printf ("Matrix layout : %s line %d error\r\n",
+                        MATRIX_LAYOUT_FILE, layout.get_error_line());
+
+    // Default SPI 1Mhz, HW cs = true
+    matrix.begin (X_DOTS, Y_DOTS, MatrixMap, 2000000, true);
+    // Dot matrix brightness (1 ~ 15)
+    matrix.brightness(3);
+}
+
+//------------------------------------------------------------------------------
+void show_marquee (int x_offset)
+{
+    /* render the glyphs of the window, matrix draw buffer <- ring fb and show */
+    marquee->show(matrix, x_offset);
+    marquee_pos = x_offset;
     if (!x_offset)
         delay(1000);
     /*
@@ -160,6 +191,28 @@ void copy_fb_to_matrix (int x_offset, int y_offset)
     ota_loop();
 }
 
+//------------------------------------------------------------------------------
+// shown view of the old text. (before set_text)
+void transition_begin ()
+{
+    marquee->copy_view(transition->get_from(), marquee_pos);
+}
+
+//------------------------------------------------------------------------------
+// old view -> new text at x = 0 with the effect. (after set_text)
+void transition_show (int effect)
+{
+    marquee->copy_view(transition->get_to(), 0);
+    /* one line per frame for the vertical effects */
+    transition->start(effect, matrix.get_height());
+    /* frames are paced by the matrix refresh (present) */
+    while (transition->show(matrix))
+        ota_loop();
+
+    marquee_pos = 0;
+    delay(1000);
+}
+
 //------------------------------------------------------------------------------
 void setup()
 {
@@ -173,13 +226,19 @@ void setup()
     timeClient.setTimeOffset(32400);    // 한국은 GMT+9이므로 9*3600=32400
     timeClient.update();
 
-    // Dot matrix brightness (1 ~ 15)
-    matrix.brightness(3);
+    // Dot matrix init (layout file or default map)
+    matrix_begin();
+    // Dot matrix refresh timer start
+    matrix.start_refresh(MATRIX_FPS);
+    marquee = new lib_marquee(matrix.get_width(), matrix.get_height());
+    // variable width glyphs : shorter scroll per message
+    marquee->get_fb().set_proportional(true);
+    transition = new lib_transition(matrix.get_width(), matrix.get_height());
     // weather request period 5 min.
     weather.set_period_ms(5 * 60 * 1000);
 
-    fb.draw_text(0, 0, 1, "WIFI Init...");
-    copy_fb_to_matrix (0, 0);
+    marquee->set_text("WIFI Init...");
+    show_marquee (0);
 
 #if defined(F_WIFI_SETUP)
     WiFi.begin(F_WIFI_SSID, F_WIFI_PASS);
@@ -198,7 +257,7 @@ void setup()
     /*
         OTA 환경 설정(callback function init)
         ota_loop()함수는 프로그램 동작중 가장많이 실행되는 함수 또는 위치에 실행하도록 설정한다.
-        이 프로그램에서 가장 많이 사용되는 함수는 copy_fb_to_matrix 이므로 function하단에
+        이 프로그램에서 가장 많이 사용되는 함수는 show_marquee 이므로 function하단에
         해당 function을 호출하도록 한다.
     */
     ota_setup();
@@ -211,19 +270,6 @@ void loop()
     timeClient.update();
     {
         struct tm *ptm = get_tm(&timeClient);
-        int draw_x_w;
-
-        fb.clear();
-
-        draw_x_w = fb.draw_text(0, 0, 1,
-            "NTP Server 현재시간 : %d년 %d월 %d일, %d시 %d분 %d초 %s. ",
-            ptm->tm_year + 1900,
-            ptm->tm_mon+1,
-            ptm->tm_mday,
-            timeClient.getHours(),
-            timeClient.getMinutes(),
-            timeClient.getSeconds(),
-            daysOfTheWeek[(int)timeClient.getDay()]);
 
         if (weather.request_data()) {
             String *Temp = weather.get_data(W_DATA_TEMP);
@@ -233,7 +279,18 @@ void loop()
             String *Ws = weather.get_data(W_DATA_WS);
             String *Pop = weather.get_data(W_DATA_POP);
 
-            draw_x_w += fb.draw_text(draw_x_w, 0, 1,
+            transition_begin();
+            marquee->set_text(
+                "NTP Server 현재시간 : %d년 %d월 %d일, %d시 %d분 %d초 %s. ",
+                ptm->tm_year + 1900,
+                ptm->tm_mon+1,
+                ptm->tm_mday,
+                timeClient.getHours(),
+                timeClient.getMinutes(),
+                timeClient.getSeconds(),
+                daysOfTheWeek[(int)timeClient.getDay()]);
+
+            marquee->add_text(
                 "%s 날씨 : 온도 %s도, 습도 %s%%, 풍향 %s, 풍속 %3.1fm/s, 강수확률 %s%%, 하늘 %s.",
                 weather.get_location_str(),
                 Temp->c_str(),
@@ -242,18 +299,16 @@ void loop()
                 atof(Ws->c_str()),
                 Pop->c_str(),
                 WfKor->c_str());
+            transition_show(FB_TR_PUSH_UP);
 
-            for (int i = 0; i < draw_x_w; i++) {
-                copy_fb_to_matrix (i, 0);
-                digitalWrite(2, 1);
-                delay(5);
-                digitalWrite(2, 0);
-                delay(5);
+            for (int i = 1; i < marquee->get_width(); i++) {
+                digitalWrite(2, i & 1);
+                show_marquee (i);
             }
 
-            fb.clear();
-            fb.draw_text(0, 0, 1, "날씨 로딩중..");
-            copy_fb_to_matrix (0, 0);
+            transition_begin();
+            marquee->set_text("날씨 로딩중..");
+            transition_show(FB_TR_SLIDE_DOWN);
 
             if ((loc = !loc)) {
                 weather.set_rss_url("의왕시 오전동", "/wid/queryDFSRSS.jsp?zone=4143053000");